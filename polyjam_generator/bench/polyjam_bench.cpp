@@ -0,0 +1,419 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+//Microbenchmarks of the core of the generator. All inputs are drawn from a
+//fixed seed, such that runs can be compared. The results are written as JSON.
+//
+//usage: polyjam_bench [output.json] [repetitions]
+
+#include <polyjam/polyjam.hpp>
+#include <polyjam/core/Counters.hpp>
+#include <polyjam/core/MonomialOrder.hpp>
+#include <polyjam/generator/CMatrix.hpp>
+#include <polyjam/math/GaussJordan.hpp>
+
+#include <fstream>
+#include <algorithm>
+#include <memory>
+#include <sys/time.h>
+
+namespace
+{
+
+struct Result
+{
+  std::string name;
+  std::string field;
+  size_t size;
+  std::vector<double> times; //[us]
+  Counters counts;           //of the last repetition
+};
+
+std::vector<Result> results;
+int repetitions = 20;
+
+double
+wallTime()
+{
+  struct timeval now;
+  gettimeofday(&now,NULL);
+  return now.tv_sec * 1000000.0 + now.tv_usec;
+}
+
+//run setup (not timed) and body (timed) once for warm up, then repetitions times
+void
+benchmark(
+    const std::string & name,
+    const std::string & field,
+    size_t size,
+    std::function<void()> setup,
+    std::function<void()> body )
+{
+  Result result;
+  result.name = name;
+  result.field = field;
+  result.size = size;
+
+  setup();
+  body();
+
+  for( int i = 0; i < repetitions; i++ )
+  {
+    setup();
+    CounterScope counters;
+    double start = wallTime();
+    body();
+    result.times.push_back(wallTime() - start);
+    result.counts = counters.elapsed();
+  }
+
+  std::vector<double> sorted = result.times;
+  std::sort(sorted.begin(),sorted.end());
+  std::cout << name << " (" << field << ", " << size << "): median ";
+  std::cout << sorted[sorted.size()/2] << "us" << std::endl;
+  results.push_back(result);
+}
+
+//a random monomial with a total degree of at most maxDegree
+Monomial
+randomMonomial( std::mt19937 & generator, size_t dimensions, unsigned int maxDegree, Monomial::Order order = Monomial::GREVLEX )
+{
+  std::vector<unsigned int> exponents(dimensions,0);
+  unsigned int degree = generator() % (maxDegree+1);
+  for( unsigned int i = 0; i < degree; i++ )
+    exponents[generator() % dimensions]++;
+  return Monomial(exponents,order);
+}
+
+//a random polynomial with (at most) the given number of terms
+Poly
+randomPoly( GenerationContext & context, Field::Kind kind, size_t dimensions, size_t terms, unsigned int maxDegree )
+{
+  Poly result(Term(Coefficient(kind,true,context),randomMonomial(context.generator(),dimensions,maxDegree)));
+  for( size_t i = 1; i < terms; i++ )
+    result += Term(Coefficient(kind,true,context),randomMonomial(context.generator(),dimensions,maxDegree));
+  return result;
+}
+
+//a random dense matrix of coefficients
+typedef std::vector<std::vector<Coefficient>*> matrix_t;
+
+void
+randomMatrix( GenerationContext & context, Field::Kind kind, size_t rows, size_t cols, matrix_t & matrix )
+{
+  for( size_t r = 0; r < matrix.size(); r++ )
+    delete matrix[r];
+  matrix.clear();
+
+  for( size_t r = 0; r < rows; r++ )
+  {
+    matrix.push_back(new std::vector<Coefficient>());
+    for( size_t c = 0; c < cols; c++ )
+    {
+      if( kind == Field::Sym )
+      {
+        std::stringstream name; name << "m(" << r << "," << c << ")";
+        matrix.back()->push_back(Coefficient(name.str()));
+      }
+      else
+        matrix.back()->push_back(Coefficient(kind,true,context));
+    }
+  }
+}
+
+std::string
+fieldName( Field::Kind kind )
+{
+  switch( kind )
+  {
+    case Field::R:
+      return "R";
+    case Field::Q:
+      return "Q";
+    case Field::Zp:
+      return "Zp";
+    case Field::Sym:
+      return "Sym";
+    default:
+      return "";
+  }
+}
+
+void
+benchMonomials( GenerationContext & context )
+{
+  const char * names[] = {"lex","revlex","grlex","grevlex"};
+  Monomial::Order orders[] = {Monomial::LEX,Monomial::REVLEX,Monomial::GRLEX,Monomial::GREVLEX};
+  size_t number = 10000;
+
+  for( int o = 0; o < 4; o++ )
+  {
+    std::shared_ptr<std::vector<Monomial> > monomials(new std::vector<Monomial>());
+    for( size_t i = 0; i < number; i++ )
+      monomials->push_back(randomMonomial(context.generator(),6,8,orders[o]));
+
+    std::shared_ptr<int> sink(new int(0));
+    benchmark( std::string("monomial comparison ") + names[o], "-", number,
+        [](){},
+        [=]()
+        {
+          for( size_t i = 1; i < monomials->size(); i++ )
+            (*sink) += (*monomials)[i].comparison((*monomials)[i-1],(*monomials)[i].order());
+        });
+  }
+
+  //sorting with the order of the objects against the order known at compile time
+  std::shared_ptr<std::vector<Monomial> > monomials(new std::vector<Monomial>());
+  for( size_t i = 0; i < number; i++ )
+    monomials->push_back(randomMonomial(context.generator(),6,8));
+  std::shared_ptr<std::vector<Monomial> > sorted(new std::vector<Monomial>());
+
+  benchmark( "monomial sort runtime order", "-", number,
+      [=](){ *sorted = *monomials; },
+      [=](){ std::sort( sorted->begin(), sorted->end(), std::greater<Monomial>() ); } );
+  benchmark( "monomial sort GrevlexGreater", "-", number,
+      [=](){ *sorted = *monomials; },
+      [=](){ std::sort( sorted->begin(), sorted->end(), GrevlexGreater() ); } );
+}
+
+void
+benchPolys( GenerationContext & context )
+{
+  Field::Kind kinds[] = {Field::Zp,Field::R};
+  size_t sizes[] = {10,50,200};
+
+  for( int k = 0; k < 2; k++ )
+  {
+    for( int s = 0; s < 3; s++ )
+    {
+      std::shared_ptr<Poly> a(new Poly(randomPoly(context,kinds[k],4,sizes[s],6)));
+      std::shared_ptr<Poly> b(new Poly(randomPoly(context,kinds[k],4,sizes[s],6)));
+
+      benchmark( "poly addition", fieldName(kinds[k]), sizes[s],
+          [](){},
+          [=](){ Poly result = (*a) + (*b); } );
+      benchmark( "poly multiplication", fieldName(kinds[k]), sizes[s],
+          [](){},
+          [=](){ Poly result = (*a) * (*b); } );
+    }
+  }
+}
+
+void
+benchPolyMatrices( GenerationContext & context )
+{
+  //the matrices of the sw6pt example: F = F1 x + F2 y + F3, and F Q F^T Q
+  size_t nu = 3;
+  std::shared_ptr<PolyMatrix> F(new PolyMatrix(Poly::zeroSZ(nu),3,3));
+  std::shared_ptr<PolyMatrix> Q(new PolyMatrix(Poly::oneSZ(nu),3,3,true));
+  Poly x = Poly::uSZ(1,nu);
+  Poly y = Poly::uSZ(2,nu);
+  (*Q)(2,2) = Poly::uSZ(3,nu);
+
+  for( int r = 0; r < 3; r++ )
+  {
+    for( int c = 0; c < 3; c++ )
+    {
+      std::stringstream name1; name1 << "F1(" << r << "," << c << ")";
+      std::stringstream name2; name2 << "F2(" << r << "," << c << ")";
+      std::stringstream name3; name3 << "F3(" << r << "," << c << ")";
+      (*F)(r,c) =
+          Poly(Term(Coefficient(name1.str()),Coefficient(Field::Zp,true,context),Monomial(nu))) * x +
+          Poly(Term(Coefficient(name2.str()),Coefficient(Field::Zp,true,context),Monomial(nu))) * y +
+          Poly(Term(Coefficient(name3.str()),Coefficient(Field::Zp,true,context),Monomial(nu)));
+    }
+  }
+
+  benchmark( "polymatrix product F Q Ft Q", "SymZp", 3,
+      [](){},
+      [=](){ PolyMatrix result = (*F) * (*Q) * F->transpose() * (*Q); } );
+  benchmark( "polymatrix determinant", "SymZp", 3,
+      [](){},
+      [=](){ Poly result = F->determinant(); } );
+
+  std::shared_ptr<PolyMatrix> FQFtQ(new PolyMatrix((*F) * (*Q) * F->transpose() * (*Q)));
+  benchmark( "polymatrix product FQFtQ F", "SymZp", 3,
+      [](){},
+      [=](){ PolyMatrix result = (*FQFtQ) * (*F); } );
+}
+
+void
+benchCMatrix( GenerationContext & context )
+{
+  //random dense quadrics in three unknowns, expanded by all monomials up to a degree
+  size_t nu = 3;
+  std::vector<Poly> equations;
+  for( size_t i = 0; i < nu; i++ )
+  {
+    Poly equation(Term(Coefficient(Field::Zp,true,context),Monomial(nu)));
+    for( size_t j = 1; j <= nu; j++ )
+    {
+      equation += Term(Coefficient(Field::Zp,true,context),Monomial(nu,j));
+      for( size_t l = j; l <= nu; l++ )
+        equation += Term(Coefficient(Field::Zp,true,context),Monomial(nu,j)*Monomial(nu,l));
+    }
+    equations.push_back(equation);
+  }
+
+  for( unsigned int degree = 1; degree <= 4; degree++ )
+  {
+    //all monomials up to degree
+    std::vector<Monomial> expanders(1,Monomial(nu));
+    for( size_t i = 0; i < expanders.size(); i++ )
+    {
+      if( expanders[i].degree() == degree )
+        continue;
+      for( size_t j = 1; j <= nu; j++ )
+      {
+        Monomial next = expanders[i] * Monomial(nu,j);
+        if( std::find(expanders.begin(),expanders.end(),next) == expanders.end() )
+          expanders.push_back(next);
+      }
+    }
+
+    std::shared_ptr<CMatrix::polynomials_t> expanded(new CMatrix::polynomials_t());
+    for( size_t i = 0; i < equations.size(); i++ )
+    {
+      for( size_t j = 0; j < expanders.size(); j++ )
+        expanded->push_back(new Poly(equations[i] * Term(Coefficient(1,Field::Zp),expanders[j])));
+    }
+
+    benchmark( "cmatrix construction", "Zp", expanded->size(),
+        [](){},
+        [=](){ CMatrix matrix(*expanded); } );
+
+    std::shared_ptr<std::unique_ptr<CMatrix> > matrix(new std::unique_ptr<CMatrix>());
+    benchmark( "cmatrix reduction", "Zp", expanded->size(),
+        [=](){ matrix->reset(new CMatrix(*expanded)); },
+        [=](){ (*matrix)->reduce(); } );
+  }
+}
+
+void
+benchGaussReduction( GenerationContext & context )
+{
+  Field::Kind kinds[] = {Field::Zp,Field::R,Field::Q};
+  size_t maxSizes[] = {128,128,16};
+
+  for( int k = 0; k < 3; k++ )
+  {
+    for( size_t size = 8; size <= maxSizes[k]; size *= 2 )
+    {
+      std::shared_ptr<matrix_t> matrix(new matrix_t());
+      Field::Kind kind = kinds[k];
+      benchmark( "gauss reduction", fieldName(kind), size,
+          [=,&context](){ randomMatrix(context,kind,size,size+size/2,*matrix); },
+          [=](){ math::gaussReduction(*matrix); } );
+    }
+  }
+
+  //symbolic coefficients have no division (and the expressions explode
+  //in a full elimination), so only the row updates row -= factor * pivotRow
+  //of the first elimination step are measured
+  for( size_t size = 8; size <= 64; size *= 2 )
+  {
+    std::shared_ptr<matrix_t> matrix(new matrix_t());
+    benchmark( "row updates", "Sym", size,
+        [=,&context](){ randomMatrix(context,Field::Sym,size,size,*matrix); },
+        [=]()
+        {
+          for( size_t row = 1; row < size; row++ )
+          {
+            Coefficient factor = (*(*matrix)[row])[0].clone();
+            for( size_t col = 0; col < size; col++ )
+              (*(*matrix)[row])[col] -= factor * (*(*matrix)[0])[col];
+          }
+        });
+  }
+}
+
+void
+saveJson( std::ostream & file, unsigned int seed )
+{
+  file.precision(12);
+  file << "{\"seed\":" << seed << ",\"repetitions\":" << repetitions;
+  file << ",\"counters\":" << (Counters::enabled() ? "true" : "false");
+  file << ",\"benchmarks\":[" << std::endl;
+  for( size_t i = 0; i < results.size(); i++ )
+  {
+    const Result & result = results[i];
+    std::vector<double> sorted = result.times;
+    std::sort(sorted.begin(),sorted.end());
+    double mean = 0.0;
+    for( size_t t = 0; t < sorted.size(); t++ )
+      mean += sorted[t] / sorted.size();
+
+    file << "{\"name\":\"" << result.name << "\",\"field\":\"" << result.field << "\"";
+    file << ",\"size\":" << result.size;
+    file << ",\"min_us\":" << sorted.front();
+    file << ",\"median_us\":" << sorted[sorted.size()/2];
+    file << ",\"mean_us\":" << mean;
+    file << ",\"max_us\":" << sorted.back();
+    if( Counters::enabled() )
+    {
+      const Counters & c = result.counts;
+      file << ",\"field_operations\":" << c.fieldAdditions + c.fieldSubtractions +
+          c.fieldMultiplications + c.fieldDivisions + c.fieldNegations + c.fieldInversions;
+      file << ",\"field_allocations\":" << c.fieldAllocations;
+      file << ",\"coefficient_clones\":" << c.coefficientClones;
+      file << ",\"term_insertions\":" << c.termInsertions;
+    }
+    file << "}";
+    if( i + 1 < results.size() )
+      file << ",";
+    file << std::endl;
+  }
+  file << "]}" << std::endl;
+}
+
+}
+
+int main( int argc, char** argv )
+{
+  std::string output;
+  if( argc > 1 )
+    output = argv[1];
+  if( argc > 2 )
+    repetitions = std::max(1,atoi(argv[2]));
+
+  unsigned int seed = 1;
+  GenerationContext context(seed,"","");
+  GenerationContext::Scope scope(context);
+
+  benchMonomials(context);
+  benchPolys(context);
+  benchPolyMatrices(context);
+  benchCMatrix(context);
+  benchGaussReduction(context);
+
+  if( output.empty() )
+    saveJson(std::cout,seed);
+  else
+  {
+    std::ofstream file(output.c_str());
+    if( !file.is_open() )
+    {
+      std::cout << "Error: could not write " << output << std::endl;
+      return 1;
+    }
+    saveJson(file,seed);
+  }
+  return 0;
+}
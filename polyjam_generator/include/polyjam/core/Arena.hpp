@@ -0,0 +1,181 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+/**
+ * \file Arena.hpp
+ * \brief Scoped arenas for the short-lived objects of a generation phase.
+ */
+
+#ifndef POLYJAM_CORE_ARENA_HPP_
+#define POLYJAM_CORE_ARENA_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include <mutex>
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+/**
+ * \brief The namespace of the core objects of polynomials
+ */
+namespace core
+{
+
+/**
+ * The class Arena provides the memory for the many small objects that are
+ * created and destroyed during a phase of the generation (currently the terms
+ * of the polynomials, see ArenaAllocator). An arena is opened by a Scope, and
+ * is used by the thread that opened it until the scope ends. The memory comes
+ * in big chunks, freed blocks are reused for blocks of the same size, and all
+ * chunks are given back in one shot once the scope has ended and the last
+ * block is freed. Blocks that outlive the scope (e.g. the terms of a returned
+ * polynomial) are therefore fine, they only keep the chunks around a bit
+ * longer. Outside of any scope, the blocks come from the heap.
+ */
+class Arena
+{
+public:
+
+  /**
+   * \brief Scoped activation of a new arena for the calling thread.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * \brief Open a new arena, which is used until the scope ends.
+     */
+    Scope();
+    /**
+     * Destructor, closes the arena and reactivates the previous one.
+     */
+    ~Scope();
+
+  private:
+    Scope( const Scope & scope ) = delete;
+    Scope & operator=( const Scope & scope ) = delete;
+
+    Arena * _arena;
+    Arena * _previous;
+  };
+
+  /**
+   * \brief Allocate a block from the current arena of this thread (or from
+   *        the heap if there is none).
+   * \param[in] size The size of the block in bytes.
+   * \return The block.
+   */
+  static void * allocate( size_t size );
+  /**
+   * \brief Free a block (from any thread).
+   * \param[in] block The block returned by allocate.
+   */
+  static void deallocate( void * block );
+
+private:
+  /** Every block starts with a header that leads back to its arena */
+  struct Header
+  {
+    Arena * arena;
+    size_t sizeClass;
+  };
+  /** A freed block */
+  struct FreeBlock
+  {
+    FreeBlock * next;
+  };
+
+  /** The size of a chunk */
+  static const size_t CHUNK_SIZE = 64 * 1024;
+  /** The block sizes are multiples of this (keeps the alignment of new) */
+  static const size_t GRANULARITY = sizeof(Header);
+  /** Bigger blocks are taken from the heap */
+  static const size_t MAX_BLOCK_SIZE = 256;
+  static const size_t NUMBER_SIZE_CLASSES = MAX_BLOCK_SIZE / GRANULARITY;
+
+  Arena();
+  ~Arena();
+  Arena( const Arena & arena ) = delete;
+  Arena & operator=( const Arena & arena ) = delete;
+
+  void * get( size_t sizeClass );
+  void put( Header * header );
+  void close();
+
+  /** Blocks may be freed by other threads */
+  std::mutex _mutex;
+  std::vector<char*> _chunks;
+  char * _position;
+  char * _end;
+  FreeBlock * _free[NUMBER_SIZE_CLASSES];
+  /** The number of blocks in use */
+  size_t _used;
+  /** Has the scope of this arena ended? */
+  bool _closed;
+};
+
+/**
+ * The class ArenaAllocator is a standard allocator on top of Arena. All
+ * instances are equal, each block remembers its own arena.
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+  typedef T value_type;
+
+  ArenaAllocator() {}
+  template<typename U>
+  ArenaAllocator( const ArenaAllocator<U> & allocator ) {}
+
+  T * allocate( size_t n )
+  {
+    return static_cast<T*>( Arena::allocate( n * sizeof(T) ) );
+  }
+
+  void deallocate( T * block, size_t n )
+  {
+    Arena::deallocate(block);
+  }
+};
+
+template<typename T, typename U>
+inline bool
+operator==( const ArenaAllocator<T> & a1, const ArenaAllocator<U> & a2 )
+{
+  return true;
+}
+
+template<typename T, typename U>
+inline bool
+operator!=( const ArenaAllocator<T> & a1, const ArenaAllocator<U> & a2 )
+{
+  return false;
+}
+
+}
+}
+
+#endif /* POLYJAM_CORE_ARENA_HPP_ */
@@ -33,6 +33,10 @@
 #include <memory>
 
 #include <polyjam/fields/Field.hpp>
+#include <polyjam/fields/R.hpp>
+#include <polyjam/fields/Q.hpp>
+#include <polyjam/fields/Zp.hpp>
+#include <polyjam/core/GenerationContext.hpp>
 
 /**
  * \brief The namespace of this library.
@@ -52,7 +56,12 @@ namespace core
  * the factory pattern to create coefficients from different fields, and
  * therefore prevents the use of templates throughout the rest of the library.
  *
- * Careful: assignment and copy is lazy by default!
+ * Members of the numeric fields (R, Q and Zp) are stored inside the
+ * coefficient, so creating, copying and destroying them does not touch the
+ * heap. Symbolic members are kept on the heap, and assignment and copy are
+ * lazy for them: copies share the member until one of them is modified, at
+ * which point the modified copy detaches itself (copy-on-write). Use clone()
+ * to force a deep copy.
  */
 class Coefficient
 {
@@ -64,11 +73,19 @@ public:
   // Constructors
 
   /**
-   * \brief Creates a zero member of a certain field.
+   * \brief Creates a zero member of a certain field (in the current context).
    * \param[in] kind The kind of Field.
    * \param[in] random Set the coefficient to random (only if not Symbolic).
    */
   Coefficient( fields::Field::Kind kind, bool random = false );
+  /**
+   * \brief Creates a zero member of a certain field.
+   * \param[in] kind The kind of Field.
+   * \param[in] random Set the coefficient to random (only if not Symbolic).
+   * \param[in] context The context providing the random numbers and the
+   *            characteristic of Zp.
+   */
+  Coefficient( fields::Field::Kind kind, bool random, GenerationContext & context );
   /**
    * \brief Constructor for a member of R.
    * \param[in] value The value of the coefficient.
@@ -82,7 +99,7 @@ public:
   Coefficient( int numerator, unsigned int denominator );
   /**
    * \brief Constructor for a constant in any field. Interesting for
-   *        Zp and Symbolic.
+   *        Zp and Symbolic (Zp is taken from the current context).
    * \param[in] constant The value of the coefficient.
    * \param[in] kind The kind of field we want this constant to be on?
    */
@@ -105,6 +122,31 @@ public:
    */
   virtual ~Coefficient();
   
+  // lazy copy and move
+  
+  /**
+   * \brief Copy constructor (shares a symbolic field until modified).
+   * \param[in] coefficient The original.
+   */
+  Coefficient( const Coefficient & coefficient );
+  /**
+   * \brief Move constructor.
+   * \param[in] coefficient The original, left without a field.
+   */
+  Coefficient( Coefficient && coefficient );
+  /**
+   * \brief Assignment (shares a symbolic field until modified).
+   * \param[in] coefficient The original.
+   * \return A reference to this coefficient.
+   */
+  Coefficient & operator=( const Coefficient & coefficient );
+  /**
+   * \brief Move assignment.
+   * \param[in] coefficient The original, left without a field.
+   * \return A reference to this coefficient.
+   */
+  Coefficient & operator=( Coefficient && coefficient );
+  
   // deep copy stuff
   
   /**
@@ -158,6 +200,11 @@ public:
    * \return Characteristic.
    */
   unsigned int characteristic() const;
+  /**
+   * \brief Get the value of the prime field member (of course only works for Zp)
+   * \return Value.
+   */
+  unsigned int zpValue() const;
 
   // standard operations
   
@@ -294,16 +341,64 @@ public:
    */
   bool isOne() const;
   
+  /**
+   * \brief A hash of the value (equal coefficients have the same hash).
+   * \return The hash.
+   */
+  size_t hash() const;
+  
 private:
 
-  /** The value/field of this coefficient */
+  /** The symbolic field of this coefficient (shared until modified) */
   FieldPtr _field;
+  /** The storage of a numeric field of this coefficient */
+  union Local
+  {
+    Local() {}
+    ~Local() {}
+    fields::R r;
+    fields::Q q;
+    fields::Zp zp;
+  } _local;
+  /** The value/field of this coefficient (either in _local or _field) */
+  fields::Field * _value;
   
   /**
-   * \brief Another constructor (lazy copy, only used internally!)
-   * \param[in] field The original.
+   * \brief Another constructor (takes ownership, only used internally!)
+   * \param[in] field The field member allocated on the heap.
    */
   Coefficient( fields::Field * field );
+  /**
+   * \brief Another constructor (copies the member, only used internally!)
+   * \param[in] field The field member.
+   */
+  Coefficient( const fields::Field & field );
+  
+  /**
+   * \brief Is the field member stored inside this coefficient?
+   * \return True for members of R, Q and Zp.
+   */
+  bool isLocal() const;
+  /**
+   * \brief Set the field member of this coefficient (the old one needs to be
+   *        released).
+   * \param[in] field The field member to be copied.
+   */
+  void setValue( const fields::Field * field );
+  /**
+   * \brief Let go of the field member of this coefficient.
+   */
+  void release();
+  /**
+   * \brief Take over the field member of another coefficient (the old one
+   *        needs to be released).
+   * \param[in] coefficient The original.
+   */
+  void assign( const Coefficient & coefficient );
+  /**
+   * \brief Give this coefficient its own field before it is modified.
+   */
+  void detach();
 };
 
 }
@@ -0,0 +1,225 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+/**
+ * \file CoefficientList.hpp
+ * \brief The coefficients of a term, stored inline if there are few of them.
+ */
+
+#ifndef POLYJAM_CORE_COEFFICIENTLIST_HPP_
+#define POLYJAM_CORE_COEFFICIENTLIST_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include <new>
+#include <utility>
+
+#include <polyjam/core/Coefficient.hpp>
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+/**
+ * \brief The namespace of the core objects of polynomials
+ */
+namespace core
+{
+
+/**
+ * The class CoefficientList holds the coefficients of a term. A term has one
+ * coefficient, or two in the multiple-field (symbolic and Zp) case, so the
+ * first INLINE_SIZE coefficients are stored inside the list itself, and only
+ * further ones go to the heap. Together with the inline numeric fields of
+ * Coefficient, this means that creating a numeric term does not allocate.
+ */
+class CoefficientList
+{
+public:
+  /** The number of coefficients that are stored inline */
+  static const size_t INLINE_SIZE = 2;
+
+  CoefficientList();
+  CoefficientList( const std::vector<Coefficient> & coefficients );
+  CoefficientList( const CoefficientList & list );
+  CoefficientList( CoefficientList && list );
+  ~CoefficientList();
+
+  CoefficientList & operator=( const CoefficientList & list );
+  CoefficientList & operator=( CoefficientList && list );
+
+  /**
+   * \brief The number of coefficients.
+   * \return Size.
+   */
+  size_t size() const;
+  /**
+   * \brief Access a coefficient.
+   * \param[in] index The index of the coefficient (must be smaller than size).
+   * \return The coefficient.
+   */
+  Coefficient & operator[]( size_t index );
+  const Coefficient & operator[]( size_t index ) const;
+
+  /**
+   * \brief Append a coefficient.
+   * \param[in] coefficient The new coefficient.
+   */
+  void push_back( const Coefficient & coefficient );
+  void push_back( Coefficient && coefficient );
+  /**
+   * \brief Remove all coefficients.
+   */
+  void clear();
+
+private:
+  /** The storage of the inline coefficients (only the first _size are alive) */
+  union Storage
+  {
+    Storage() {}
+    ~Storage() {}
+    Coefficient items[INLINE_SIZE];
+  } _inline;
+  /** The number of coefficients */
+  size_t _size;
+  /** The coefficients that do not fit inline */
+  std::vector<Coefficient> _overflow;
+};
+
+inline
+CoefficientList::CoefficientList() : _size(0)
+{}
+
+inline
+CoefficientList::CoefficientList( const std::vector<Coefficient> & coefficients ) :
+    _size(0)
+{
+  for( size_t i = 0; i < coefficients.size(); i++ )
+    push_back(coefficients[i]);
+}
+
+inline
+CoefficientList::CoefficientList( const CoefficientList & list ) : _size(0)
+{
+  for( size_t i = 0; i < list.size(); i++ )
+    push_back(list[i]);
+}
+
+inline
+CoefficientList::CoefficientList( CoefficientList && list ) : _size(0)
+{
+  for( size_t i = 0; i < list._size && i < INLINE_SIZE; i++ )
+    push_back(std::move(list._inline.items[i]));
+  _overflow = std::move(list._overflow);
+  _size = list._size;
+  list.clear();
+}
+
+inline
+CoefficientList::~CoefficientList()
+{
+  clear();
+}
+
+inline CoefficientList &
+CoefficientList::operator=( const CoefficientList & list )
+{
+  if( this != &list )
+  {
+    clear();
+    for( size_t i = 0; i < list.size(); i++ )
+      push_back(list[i]);
+  }
+  return (*this);
+}
+
+inline CoefficientList &
+CoefficientList::operator=( CoefficientList && list )
+{
+  if( this != &list )
+  {
+    clear();
+    for( size_t i = 0; i < list._size && i < INLINE_SIZE; i++ )
+      push_back(std::move(list._inline.items[i]));
+    _overflow = std::move(list._overflow);
+    _size = list._size;
+    list.clear();
+  }
+  return (*this);
+}
+
+inline size_t
+CoefficientList::size() const
+{
+  return _size;
+}
+
+inline Coefficient &
+CoefficientList::operator[]( size_t index )
+{
+  if( index < INLINE_SIZE )
+    return _inline.items[index];
+  return _overflow[index-INLINE_SIZE];
+}
+
+inline const Coefficient &
+CoefficientList::operator[]( size_t index ) const
+{
+  if( index < INLINE_SIZE )
+    return _inline.items[index];
+  return _overflow[index-INLINE_SIZE];
+}
+
+inline void
+CoefficientList::push_back( const Coefficient & coefficient )
+{
+  if( _size < INLINE_SIZE )
+    new (&_inline.items[_size]) Coefficient(coefficient);
+  else
+    _overflow.push_back(coefficient);
+  _size++;
+}
+
+inline void
+CoefficientList::push_back( Coefficient && coefficient )
+{
+  if( _size < INLINE_SIZE )
+    new (&_inline.items[_size]) Coefficient(std::move(coefficient));
+  else
+    _overflow.push_back(std::move(coefficient));
+  _size++;
+}
+
+inline void
+CoefficientList::clear()
+{
+  for( size_t i = 0; i < _size && i < INLINE_SIZE; i++ )
+    _inline.items[i].~Coefficient();
+  _overflow.clear();
+  _size = 0;
+}
+
+}
+}
+
+#endif /* POLYJAM_CORE_COEFFICIENTLIST_HPP_ */
@@ -0,0 +1,132 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+/**
+ * \file Counters.hpp
+ * \brief Optional counters of the operations in the core algebra.
+ */
+
+#ifndef POLYJAM_CORE_COUNTERS_HPP_
+#define POLYJAM_CORE_COUNTERS_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string>
+
+/**
+ * Count an event (only if the library is compiled with POLYJAM_COUNTERS,
+ * nothing otherwise).
+ */
+#ifdef POLYJAM_COUNTERS
+#define POLYJAM_COUNT(counter) (++polyjam::core::Counters::local().counter)
+#else
+#define POLYJAM_COUNT(counter) ((void) 0)
+#endif
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+/**
+ * \brief The namespace of the core objects of polynomials
+ */
+namespace core
+{
+
+/**
+ * The struct Counters holds the number of field operations, constructions of
+ * field members (inline or on the heap), Coefficient clones, Term constructions and Poly term
+ * insertions of the calling thread. The counters are only maintained if the
+ * library is compiled with POLYJAM_COUNTERS, they are all zero otherwise.
+ */
+struct Counters
+{
+  unsigned long long fieldAdditions;
+  unsigned long long fieldSubtractions;
+  unsigned long long fieldMultiplications;
+  unsigned long long fieldDivisions;
+  unsigned long long fieldNegations;
+  unsigned long long fieldInversions;
+  unsigned long long fieldAllocations;
+  unsigned long long coefficientClones;
+  unsigned long long termConstructions;
+  unsigned long long termInsertions;
+
+  Counters();
+
+  /**
+   * \brief The difference between two snapshots.
+   * \param[in] earlier The earlier snapshot.
+   * \return The counts that happened in between.
+   */
+  Counters operator-( const Counters & earlier ) const;
+
+  /**
+   * \brief Get a readable string of all counters.
+   * \return The string.
+   */
+  std::string getString() const;
+
+  /**
+   * \brief Are the counters maintained in this build?
+   * \return True if the library is compiled with POLYJAM_COUNTERS.
+   */
+  static bool enabled();
+  /**
+   * \brief The running counters of the calling thread.
+   * \return The counters.
+   */
+  static Counters & local();
+  /**
+   * \brief A copy of the running counters of the calling thread.
+   * \return The snapshot.
+   */
+  static Counters snapshot();
+};
+
+/**
+ * The class CounterScope takes a snapshot of the counters at construction,
+ * and returns what has been counted since.
+ */
+class CounterScope
+{
+public:
+  CounterScope();
+
+  /**
+   * \brief The counts since the construction (or the last reset).
+   * \return The difference to the snapshot.
+   */
+  Counters elapsed() const;
+  /**
+   * \brief Take a new snapshot.
+   */
+  void reset();
+
+private:
+  Counters _start;
+};
+
+}
+}
+
+#endif /* POLYJAM_CORE_COUNTERS_HPP_ */
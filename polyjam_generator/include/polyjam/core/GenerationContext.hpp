@@ -0,0 +1,192 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+/**
+ * \file GenerationContext.hpp
+ * \brief The state of one solver generation (random numbers, paths, options).
+ */
+
+#ifndef POLYJAM_CORE_GENERATIONCONTEXT_HPP_
+#define POLYJAM_CORE_GENERATIONCONTEXT_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string>
+#include <random>
+
+#include <polyjam/fields/Zp.hpp>
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+/**
+ * \brief The namespace of the core objects of polynomials
+ */
+namespace core
+{
+
+/**
+ * The class GenerationContext holds everything a solver generation depends
+ * on: the random number generator for the random instances, the output
+ * paths, the characteristic of the prime field, and the configuration of the
+ * generator. Two generations with different contexts do not share any state,
+ * and may therefore run concurrently in different threads.
+ *
+ * The interfaces without an explicit context use the current context of the
+ * calling thread (see current() and Scope).
+ */
+class GenerationContext
+{
+public:
+
+  /**
+   * The configuration of the generator.
+   */
+  struct Options
+  {
+    /** Save the matrix before the pre-elimination (for hand-crafted pre-eliminations) */
+    bool saveBeforePreElimination;
+    /** Save the matrix after the pre-elimination (for hand-crafted pre-eliminations) */
+    bool saveAfterPreElimination;
+    /** Save the template before the elimination */
+    bool saveBeforeElimination;
+    /** Save the template after the elimination (if the Action matrix won't work) */
+    bool saveAfterElimination;
+    /** Save the polynomials (if the Action matrix won't work) */
+    bool savePolynomials;
+    /** Save the monomials (if the Action matrix won't work) */
+    bool saveMonomials;
+    /** Use Gauss-Jordan instead of the LU decomposition in the pre-elimination */
+    bool useGaussJordan;
+    /** Use the real Schur form and recover the eigenvectors of the real eigenvalues only */
+    bool realEigenvaluesOnly;
+    /** Like realEigenvaluesOnly, but use the non-trivial rows of Action only */
+    bool exploitTrivialRows;
+    /** Try all action variables and degrees in parallel, and pick the smallest template */
+    bool searchActionVariable;
+    /** The maximum degree of expansion for searchActionVariable */
+    int maxSearchDegree;
+    /** Seconds between two checkpoints of the template construction (0 disables them) */
+    int checkpointInterval;
+    /** Save the timings and sizes of all phases next to the solver (JSON and Chrome trace) */
+    bool profile;
+    /** Emit a benchmark program next to the solver (timings, allocations, residuals) */
+    bool saveBenchmark;
+
+    Options();
+  };
+
+  /**
+   * \brief Scoped activation of a context as the current one of this thread.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * \brief Make a context the current one until the scope ends.
+     * \param[in] context The context.
+     */
+    Scope( GenerationContext & context );
+    /**
+     * Destructor, reactivates the previous context.
+     */
+    ~Scope();
+
+  private:
+    GenerationContext * _previous;
+  };
+
+  /**
+   * \brief Constructor with a time-based seed and the default paths.
+   */
+  GenerationContext();
+  /**
+   * \brief Constructor.
+   * \param[in] seed The seed of the random number generator.
+   * \param[in] workspacePath The path of the workspace (with trailing slash).
+   * \param[in] solverPath The path of the generated solvers (with trailing slash).
+   * \param[in] characteristic The characteristic of the prime field.
+   */
+  GenerationContext(
+      unsigned int seed,
+      const std::string & workspacePath,
+      const std::string & solverPath,
+      unsigned int characteristic = DEFAULT_CHARACTERISTIC );
+
+  /**
+   * \brief Reseed the random number generator.
+   * \param[in] seed The new seed.
+   */
+  void seed( unsigned int seed );
+  /**
+   * \brief Access the random number generator.
+   * \return The random number generator of this context.
+   */
+  std::mt19937 & generator();
+
+  /**
+   * \brief The path of the workspace (cache and Macaulay2 scripts).
+   * \return The path with trailing slash.
+   */
+  const std::string & workspacePath() const;
+  /**
+   * \brief The path where the solvers are generated.
+   * \return The path with trailing slash.
+   */
+  const std::string & solverPath() const;
+  /**
+   * \brief The characteristic of the prime field used in this generation.
+   * \return The characteristic.
+   */
+  unsigned int characteristic() const;
+
+  void setWorkspacePath( const std::string & workspacePath );
+  void setSolverPath( const std::string & solverPath );
+  void setCharacteristic( unsigned int characteristic );
+
+  /**
+   * \brief The configuration of the generator.
+   * \return The options.
+   */
+  Options & options();
+  const Options & options() const;
+
+  /**
+   * \brief The current context of the calling thread (the context of the
+   *        innermost Scope, or a default context of this thread).
+   * \return The current context.
+   */
+  static GenerationContext & current();
+
+private:
+  std::mt19937 _generator;
+  std::string _workspacePath;
+  std::string _solverPath;
+  unsigned int _characteristic;
+  Options _options;
+};
+
+}
+}
+
+#endif /* POLYJAM_CORE_GENERATIONCONTEXT_HPP_ */
@@ -369,6 +369,22 @@ private:
   bool isIncompatible( const Monomial & operant ) const;
 };
 
+/**
+ * The struct MonomialHash hashes a monomial based on its exponents (for the
+ * unordered containers).
+ */
+struct MonomialHash
+{
+  size_t operator()( const Monomial & monomial ) const
+  {
+    size_t hash = 0;
+    const std::vector<unsigned int> & exponents = monomial.exponents();
+    for( size_t i = 0; i < exponents.size(); i++ )
+      hash = hash * 31 + exponents[i];
+    return hash;
+  }
+};
+
 }
 }
 
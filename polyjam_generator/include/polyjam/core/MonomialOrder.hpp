@@ -0,0 +1,205 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+/**
+ * \file MonomialOrder.hpp
+ * \brief Monomial orders resolved at compile time.
+ */
+
+#ifndef POLYJAM_CORE_MONOMIALORDER_HPP_
+#define POLYJAM_CORE_MONOMIALORDER_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+#include <polyjam/core/Monomial.hpp>
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+/**
+ * \brief The namespace of the core objects of polynomials
+ */
+namespace core
+{
+
+/**
+ * The struct OrderedComparison compares two monomials in a fixed order, such
+ * that the comparison can be inlined into the containers and algorithms that
+ * use it. The monomials must have the same number of unknowns (this is not
+ * checked here, the runtime interface of Monomial does it). The result agrees
+ * with Monomial::comparison: -1 if the first monomial is smaller, 0 if both are
+ * equal, and 1 if the first one is bigger.
+ */
+template<Monomial::Order order>
+struct OrderedComparison
+{
+  static int compare( const Monomial & m1, const Monomial & m2 );
+};
+
+template<>
+struct OrderedComparison<Monomial::LEX>
+{
+  static inline int compare( const Monomial & m1, const Monomial & m2 )
+  {
+    const std::vector<unsigned int> & e1 = m1.exponents();
+    const std::vector<unsigned int> & e2 = m2.exponents();
+    for( size_t i = 0; i < e1.size(); i++ )
+    {
+      if( e1[i] != e2[i] )
+        return ( e1[i] > e2[i] ) ? 1 : -1;
+    }
+    return 0;
+  }
+};
+
+template<>
+struct OrderedComparison<Monomial::REVLEX>
+{
+  static inline int compare( const Monomial & m1, const Monomial & m2 )
+  {
+    //from the back, see Monomial::revlexComparison
+    const std::vector<unsigned int> & e1 = m1.exponents();
+    const std::vector<unsigned int> & e2 = m2.exponents();
+    for( size_t i = e1.size(); i > 0; i-- )
+    {
+      if( e1[i-1] != e2[i-1] )
+        return ( e1[i-1] < e2[i-1] ) ? 1 : -1;
+    }
+    return 0;
+  }
+};
+
+template<>
+struct OrderedComparison<Monomial::GRLEX>
+{
+  static inline int compare( const Monomial & m1, const Monomial & m2 )
+  {
+    //one pass for the degrees and the first difference
+    const std::vector<unsigned int> & e1 = m1.exponents();
+    const std::vector<unsigned int> & e2 = m2.exponents();
+    unsigned int degree1 = 0;
+    unsigned int degree2 = 0;
+    int lex = 0;
+    for( size_t i = 0; i < e1.size(); i++ )
+    {
+      degree1 += e1[i];
+      degree2 += e2[i];
+      if( lex == 0 && e1[i] != e2[i] )
+        lex = ( e1[i] > e2[i] ) ? 1 : -1;
+    }
+    if( degree1 != degree2 )
+      return ( degree1 > degree2 ) ? 1 : -1;
+    return lex;
+  }
+};
+
+template<>
+struct OrderedComparison<Monomial::GREVLEX>
+{
+  static inline int compare( const Monomial & m1, const Monomial & m2 )
+  {
+    //one pass for the degrees and the last difference (the first from the back)
+    const std::vector<unsigned int> & e1 = m1.exponents();
+    const std::vector<unsigned int> & e2 = m2.exponents();
+    unsigned int degree1 = 0;
+    unsigned int degree2 = 0;
+    int revlex = 0;
+    for( size_t i = 0; i < e1.size(); i++ )
+    {
+      degree1 += e1[i];
+      degree2 += e2[i];
+      if( e1[i] != e2[i] )
+        revlex = ( e1[i] < e2[i] ) ? 1 : -1;
+    }
+    if( degree1 != degree2 )
+      return ( degree1 > degree2 ) ? 1 : -1;
+    return revlex;
+  }
+};
+
+/**
+ * Comparator "smaller in a fixed order", e.g. for std::set or std::sort.
+ */
+template<Monomial::Order order>
+struct OrderedLess
+{
+  inline bool operator()( const Monomial & m1, const Monomial & m2 ) const
+  {
+    return OrderedComparison<order>::compare(m1,m2) < 0;
+  }
+};
+
+/**
+ * Comparator "bigger in a fixed order", e.g. for std::set or std::sort.
+ */
+template<Monomial::Order order>
+struct OrderedGreater
+{
+  inline bool operator()( const Monomial & m1, const Monomial & m2 ) const
+  {
+    return OrderedComparison<order>::compare(m1,m2) > 0;
+  }
+};
+
+typedef OrderedLess<Monomial::LEX>        LexLess;
+typedef OrderedLess<Monomial::REVLEX>     RevlexLess;
+typedef OrderedLess<Monomial::GRLEX>      GrlexLess;
+typedef OrderedLess<Monomial::GREVLEX>    GrevlexLess;
+typedef OrderedGreater<Monomial::LEX>     LexGreater;
+typedef OrderedGreater<Monomial::REVLEX>  RevlexGreater;
+typedef OrderedGreater<Monomial::GRLEX>   GrlexGreater;
+typedef OrderedGreater<Monomial::GREVLEX> GrevlexGreater;
+
+/**
+ * Comparator "bigger" in an order that is only known at runtime. The order is
+ * resolved once per comparison, and the comparison itself is inlined.
+ */
+struct MonomialGreater
+{
+  Monomial::Order order;
+  
+  MonomialGreater( Monomial::Order order_ = Monomial::GREVLEX ) : order(order_) {}
+  
+  inline bool operator()( const Monomial & m1, const Monomial & m2 ) const
+  {
+    switch( order )
+    {
+      case Monomial::GREVLEX:
+        return OrderedComparison<Monomial::GREVLEX>::compare(m1,m2) > 0;
+      case Monomial::GRLEX:
+        return OrderedComparison<Monomial::GRLEX>::compare(m1,m2) > 0;
+      case Monomial::REVLEX:
+        return OrderedComparison<Monomial::REVLEX>::compare(m1,m2) > 0;
+      case Monomial::LEX:
+        return OrderedComparison<Monomial::LEX>::compare(m1,m2) > 0;
+    }
+    return false;
+  }
+};
+
+}
+}
+
+#endif /* POLYJAM_CORE_MONOMIALORDER_HPP_ */
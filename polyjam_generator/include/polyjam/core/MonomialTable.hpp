@@ -0,0 +1,117 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+/**
+ * \file MonomialTable.hpp
+ * \brief A table of interned monomials with integer ids.
+ */
+
+#ifndef POLYJAM_CORE_MONOMIALTABLE_HPP_
+#define POLYJAM_CORE_MONOMIALTABLE_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+
+#include <polyjam/core/Monomial.hpp>
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+/**
+ * \brief The namespace of the core objects of polynomials
+ */
+namespace core
+{
+
+/**
+ * The class MonomialTable interns monomials: every distinct monomial is
+ * stored once and gets an integer id (in the order of insertion). Products of
+ * interned monomials are cached, and the rank of each monomial in the order
+ * of the table is available, such that building and sorting the columns of a
+ * template reduces to operations on integers. A table is meant to be shared by
+ * the computations on the same system (e.g. all matrices of one template), and
+ * is not thread-safe.
+ */
+class MonomialTable
+{
+public:
+  /**
+   * \brief Constructor.
+   * \param[in] order The order in which the monomials are ranked.
+   */
+  MonomialTable( Monomial::Order order = Monomial::GREVLEX );
+
+  /**
+   * \brief Intern a monomial.
+   * \param[in] monomial The monomial.
+   * \return The id of the monomial (a new one if it is not in the table yet).
+   */
+  size_t insert( const Monomial & monomial );
+  /**
+   * \brief Look up a monomial.
+   * \param[in] monomial The monomial.
+   * \return The id of the monomial, or -1 if it is not in the table.
+   */
+  int find( const Monomial & monomial ) const;
+  /**
+   * \brief The monomial of an id.
+   * \param[in] id The id.
+   * \return The monomial.
+   */
+  const Monomial & monomial( size_t id ) const;
+  /**
+   * \brief The number of monomials in the table.
+   * \return Size.
+   */
+  size_t size() const;
+
+  /**
+   * \brief Multiply two monomials of the table (cached).
+   * \param[in] id1 The id of the first monomial.
+   * \param[in] id2 The id of the second monomial.
+   * \return The id of the product.
+   */
+  size_t multiply( size_t id1, size_t id2 );
+  /**
+   * \brief The rank of a monomial among all monomials of the table, in
+   *        descending order (the rank is recomputed after insertions).
+   * \param[in] id The id.
+   * \return The rank (0 for the biggest monomial).
+   */
+  size_t rank( size_t id );
+
+private:
+  Monomial::Order _order;
+  std::vector<Monomial> _monomials;
+  std::unordered_map<Monomial,size_t,MonomialHash> _ids;
+  std::unordered_map<uint64_t,size_t> _products;
+  std::vector<size_t> _ranks;
+};
+
+}
+}
+
+#endif /* POLYJAM_CORE_MONOMIALTABLE_HPP_ */
@@ -27,6 +27,7 @@
 #include <set>
 #include <memory>
 #include <polyjam/core/Term.hpp>
+#include <polyjam/core/Arena.hpp>
 
 //todo:
 //-possibly include the polynomial division here
@@ -56,7 +57,9 @@ namespace core
  * the assigned polynomial remains of the same type, which in turn is handy to
  * ensure consistency of PolyMatrix.
  *
- * Careful: constructions and copying are lazy. Use copy/clone if more is required!
+ * Constructions and copying are lazy: the terms are shared until one of the
+ * polynomials is modified, which then detaches itself (copy-on-write). Use
+ * copy/clone if a deep copy is required!
  */
 class Poly
 {
@@ -65,9 +68,10 @@ public:
 
   /**
    * The container for the terms. We use a set, which ensured lookup and
-   * insertion in exponential time.
+   * insertion in exponential time. The terms are sorted in descending order.
+   * The nodes come from the arena of the current phase, if any (see Arena).
    */
-  typedef std::set<Term,std::greater<Term> > terms_t;
+  typedef std::set<Term,TermGreater,ArenaAllocator<Term> > terms_t;
   /** A pointer to the terms-container */
   typedef std::shared_ptr<terms_t> termsPtr;
 
@@ -79,6 +83,17 @@ public:
    * \param[in] term The initial term.
    */
   Poly( const Term & term );
+  /**
+   * \brief Copy constructor (shares the terms until modified).
+   * \param[in] poly The original.
+   */
+  Poly( const Poly & poly ) = default;
+  /**
+   * \brief Move constructor. The original is left without terms, and can
+   *        only be assigned to or destroyed.
+   * \param[in] poly The original.
+   */
+  Poly( Poly && poly ) = default;
   /**
    * \brief Destructor.
    */
@@ -93,6 +108,12 @@ public:
    * \return A reference to this (updated) polynomial (lazy transfer!).
    */
   Poly & operator=( const Poly & rhs );
+  /**
+   * \brief Same as above, but takes over the terms of the right-hand side.
+   * \param[in] rhs The right-hand side of "=".
+   * \return A reference to this (updated) polynomial.
+   */
+  Poly & operator=( Poly && rhs );
   
   //output  
   
@@ -147,6 +168,11 @@ public:
    * \return A term which represents the leading monomial.
    */
   Term leadingMonomial() const;
+  /**
+   * \brief Get the ring of this polynomial (the one of its terms).
+   * \return The ring.
+   */
+  const Ring & ring() const;
   /**
    * \brief Get an iterator through the polynomial terms pointing at the front.
    * \return An iterator pointing at the front term.
@@ -362,6 +388,24 @@ private:
   /** The "sugar" of this polynomial. */
   unsigned int _sugar;
   
+  /**
+   * \brief Give this polynomial its own terms before they are modified.
+   */
+  void detach();
+  /**
+   * \brief Remove all terms (without touching the ones of other copies).
+   */
+  void clearTerms();
+  /**
+   * \brief Compute the product of this and another polynomial (without going
+   *        through the product cache).
+   * \param[in] operant The other polynomial.
+   * \return The product of this and another polynomial.
+   */
+  Poly product( const Poly & operant ) const;
+  
+  friend class PolyCache;
+  
 public:
   /** Useful named constructor idioms */
   
@@ -433,11 +477,21 @@ public:
   static Poly randZ( size_t dimensions, Monomial::Order order = Monomial::GREVLEX )
   { return Poly( Term::randZ(dimensions,order)); };
   
+  // rand terms drawn from a given context
+  static Poly randR( size_t dimensions, GenerationContext & context, Monomial::Order order = Monomial::GREVLEX )
+  { return Poly( Term::randR(dimensions,context,order)); };
+  static Poly randQ( size_t dimensions, GenerationContext & context, Monomial::Order order = Monomial::GREVLEX )
+  { return Poly( Term::randQ(dimensions,context,order)); };
+  static Poly randZ( size_t dimensions, GenerationContext & context, Monomial::Order order = Monomial::GREVLEX )
+  { return Poly( Term::randZ(dimensions,context,order)); };
+  
   // symbolic terms
   static Poly S( const std::string & name, size_t dimensions, Monomial::Order order = Monomial::GREVLEX )
   { return Poly(Term::S(name,dimensions,order)); };
   static Poly SrandZ( const std::string & name, size_t dimensions, Monomial::Order order = Monomial::GREVLEX )
   { return Poly(Term::SrandZ(name,dimensions,order)); };
+  static Poly SrandZ( const std::string & name, size_t dimensions, GenerationContext & context, Monomial::Order order = Monomial::GREVLEX )
+  { return Poly(Term::SrandZ(name,dimensions,context,order)); };
 };
 
 }
@@ -0,0 +1,154 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+/**
+ * \file PolyCache.hpp
+ * \brief Hash-consing of polynomials and a cache of their products.
+ */
+
+#ifndef POLYJAM_CORE_POLYCACHE_HPP_
+#define POLYJAM_CORE_POLYCACHE_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <utility>
+#include <unordered_map>
+
+#include <polyjam/core/Poly.hpp>
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+/**
+ * \brief The namespace of the core objects of polynomials
+ */
+namespace core
+{
+
+/**
+ * The class PolyCache speeds up the construction of the equations, which
+ * often multiplies the same polynomials over and over again (e.g. the
+ * entries of a rotation matrix with the coordinates of several points). It
+ * interns polynomials, such that identical ones share their terms
+ * (hash-consing), and remembers the product of every pair of interned
+ * polynomials. While a Scope is active, all products of polynomials in the
+ * calling thread go through the cache.
+ *
+ * The cache keeps all its polynomials until it is cleared or destroyed, so it
+ * is meant for the construction of the equations and not for the generation
+ * itself.
+ */
+class PolyCache
+{
+public:
+
+  /**
+   * \brief Scoped activation of a cache for the products of this thread.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * \brief Make a cache the current one until the scope ends.
+     * \param[in] cache The cache.
+     */
+    Scope( PolyCache & cache );
+    /**
+     * Destructor, reactivates the previous cache (if any).
+     */
+    ~Scope();
+
+  private:
+    PolyCache * _previous;
+  };
+
+  PolyCache();
+  virtual ~PolyCache();
+
+  /**
+   * \brief Get the shared version of a polynomial.
+   * \param[in] poly The polynomial.
+   * \return A copy of the polynomial that shares its terms with all identical
+   *         polynomials interned before.
+   */
+  Poly intern( const Poly & poly );
+  /**
+   * \brief Multiply two polynomials, or look up the product if the same
+   *        polynomials have been multiplied before.
+   * \param[in] p1 The first polynomial.
+   * \param[in] p2 The second polynomial.
+   * \return The (interned) product.
+   */
+  Poly multiply( const Poly & p1, const Poly & p2 );
+
+  /**
+   * \brief The number of distinct polynomials in the cache.
+   * \return Size.
+   */
+  size_t size() const;
+  /**
+   * \brief The number of products that have been looked up.
+   * \return Hits.
+   */
+  size_t hits() const;
+  /**
+   * \brief Forget all polynomials and products.
+   */
+  void clear();
+
+  /**
+   * \brief The current cache of the calling thread.
+   * \return The cache of the innermost Scope, or NULL if there is none.
+   */
+  static PolyCache * current();
+
+private:
+  typedef const Poly::terms_t * key_t;
+
+  struct PairHash
+  {
+    size_t operator()( const std::pair<key_t,key_t> & pair ) const
+    {
+      return std::hash<key_t>()(pair.first) * 31 + std::hash<key_t>()(pair.second);
+    }
+  };
+
+  size_t hash( const Poly & poly ) const;
+  bool isIdentical( const Poly & p1, const Poly & p2 ) const;
+
+  /** The distinct polynomials by their hash */
+  std::unordered_multimap<size_t,Poly> _polys;
+  /**
+   * The shared version of all terms seen so far, by their address (the first
+   * polynomial keeps them alive, such that the address is not reused)
+   */
+  std::unordered_map<key_t,std::pair<Poly,Poly> > _shared;
+  /** The products of pairs of shared terms */
+  std::unordered_map<std::pair<key_t,key_t>,Poly,PairHash> _products;
+  size_t _hits;
+};
+
+}
+}
+
+#endif /* POLYJAM_CORE_POLYCACHE_HPP_ */
@@ -81,11 +81,37 @@ public:
       unsigned int maxDegree,
       bool diag = false );
 
+  /**
+   * \brief Copy constructor. The elements are new polynomials, but share
+   *        their terms with the original until they are modified.
+   * \param[in] matrix The original.
+   */
+  PolyMatrix( const PolyMatrix & matrix );
+  /**
+   * \brief Move constructor.
+   * \param[in] matrix The original.
+   */
+  PolyMatrix( PolyMatrix && matrix ) = default;
   /**
    * \brief Destructor.
    */
   ~PolyMatrix();
   
+  //assignment
+  
+  /**
+   * \brief Assignment, same semantics as the copy constructor.
+   * \param[in] matrix The right-hand side of "=".
+   * \return A reference to this matrix.
+   */
+  PolyMatrix & operator=( const PolyMatrix & matrix );
+  /**
+   * \brief Move assignment.
+   * \param[in] matrix The right-hand side of "=".
+   * \return A reference to this matrix.
+   */
+  PolyMatrix & operator=( PolyMatrix && matrix ) = default;
+  
   // deep stuff
   void copy( const PolyMatrix & copy );
   PolyMatrix clone() const;
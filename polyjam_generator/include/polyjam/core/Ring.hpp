@@ -0,0 +1,173 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+/**
+ * \file Ring.hpp
+ * \brief The polynomial ring shared by monomials, terms and polynomials.
+ */
+
+#ifndef POLYJAM_CORE_RING_HPP_
+#define POLYJAM_CORE_RING_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include <polyjam/core/Monomial.hpp>
+#include <polyjam/core/Coefficient.hpp>
+#include <polyjam/core/CoefficientList.hpp>
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+/**
+ * \brief The namespace of the core objects of polynomials
+ */
+namespace core
+{
+
+class Poly;
+
+/**
+ * The class Ring describes a polynomial ring: the number of variables, the
+ * monomial order, and the field(s) of the coefficients (in the order in which
+ * a term stores them, i.e. Zp before Sym for the dual representation). Rings
+ * are unique: there is only one object per combination, so two objects are in
+ * the same ring if and only if they point to the same Ring. Every term knows
+ * its ring, which turns the compatibility checks of the operations into a
+ * comparison of two pointers.
+ *
+ * The ring can also be used to create polynomials, which avoids repeating the
+ * number of variables and the order in every named constructor.
+ */
+class Ring
+{
+public:
+  /** The fields of the coefficients of a term */
+  typedef std::vector<fields::Field::Kind> kinds_t;
+
+  /**
+   * \brief Get the unique ring of a combination.
+   * \param[in] dimensions The number of variables.
+   * \param[in] order The monomial order.
+   * \param[in] kinds The fields of the coefficients.
+   * \return The ring.
+   */
+  static const Ring & get(
+      size_t dimensions, Monomial::Order order, const kinds_t & kinds );
+  /**
+   * \brief Get the ring of a term given by its coefficients and monomial.
+   * \param[in] coefficients The coefficients.
+   * \param[in] monomial The monomial.
+   * \return The ring.
+   */
+  static const Ring & get(
+      const CoefficientList & coefficients, const Monomial & monomial );
+
+  /** The rings of the named constructors of Term and Poly */
+  static const Ring & R( size_t dimensions, Monomial::Order order = Monomial::GREVLEX );
+  static const Ring & Q( size_t dimensions, Monomial::Order order = Monomial::GREVLEX );
+  static const Ring & Z( size_t dimensions, Monomial::Order order = Monomial::GREVLEX );
+  static const Ring & S( size_t dimensions, Monomial::Order order = Monomial::GREVLEX );
+  static const Ring & SZ( size_t dimensions, Monomial::Order order = Monomial::GREVLEX );
+
+  // properties
+
+  /**
+   * \brief The number of variables.
+   * \return The number of variables.
+   */
+  size_t dimensions() const;
+  /**
+   * \brief The monomial order.
+   * \return The order.
+   */
+  Monomial::Order order() const;
+  /**
+   * \brief The fields of the coefficients.
+   * \return The kinds of the fields.
+   */
+  const kinds_t & kinds() const;
+  /**
+   * \brief Do the terms have more than one coefficient?
+   * \return Multiple representation?
+   */
+  bool isMultiple() const;
+  /**
+   * \brief A readable description, e.g. "SZ[x_1..x_6] GREVLEX".
+   * \return The description.
+   */
+  std::string getString() const;
+
+  // polynomials of this ring
+
+  /**
+   * \brief The monomial one of this ring.
+   * \return The monomial.
+   */
+  Monomial monomial() const;
+  /**
+   * \brief The zero polynomial.
+   * \return Zero.
+   */
+  Poly zero() const;
+  /**
+   * \brief The polynomial one.
+   * \return One.
+   */
+  Poly one() const;
+  /**
+   * \brief A constant polynomial (the same constant in every field).
+   * \param[in] constant The constant.
+   * \return The constant polynomial.
+   */
+  Poly constant( int constant ) const;
+  /**
+   * \brief A variable.
+   * \param[in] index The index of the variable (starting from 1).
+   * \return The polynomial x_index.
+   */
+  Poly variable( size_t index ) const;
+
+private:
+  Ring( size_t dimensions, Monomial::Order order, const kinds_t & kinds );
+  Ring( const Ring & ring ) = delete;
+  Ring & operator=( const Ring & ring ) = delete;
+
+  bool matches(
+      const CoefficientList & coefficients,
+      const Monomial & monomial ) const;
+
+  /** The number of variables */
+  size_t _dimensions;
+  /** The monomial order */
+  Monomial::Order _order;
+  /** The fields of the coefficients */
+  kinds_t _kinds;
+};
+
+}
+}
+
+#endif /* POLYJAM_CORE_RING_HPP_ */
@@ -33,6 +33,8 @@
 #include <vector>
 #include <polyjam/core/Monomial.hpp>
 #include <polyjam/core/Coefficient.hpp>
+#include <polyjam/core/CoefficientList.hpp>
+#include <polyjam/core/Ring.hpp>
 
 // todo: The printing might benefit from a function to check if negative
 
@@ -52,7 +54,9 @@ namespace core
  * Term defines a polynomial term with coefficient and monomial. Can have a
  * multiple field representation.
  *
- * Careful: contructing and copying here is lazy. Use clone/copy if more is required.
+ * Constructing and copying here is cheap: up to two coefficients are stored
+ * inside the term, numeric ones by value and symbolic ones shared until they
+ * are modified (copy-on-write). Use clone/copy if a deep copy is required.
  */
 class Term
 {
@@ -88,6 +92,31 @@ public:
   // Destructor
 	
   virtual ~Term();
+  
+  // lazy copy and move
+  
+  /**
+   * \brief Copy constructor (shares the coefficients until modified).
+   * \param[in] term The original.
+   */
+  Term( const Term & term ) = default;
+  /**
+   * \brief Move constructor.
+   * \param[in] term The original.
+   */
+  Term( Term && term ) = default;
+  /**
+   * \brief Assignment (shares the coefficients until modified).
+   * \param[in] term The original.
+   * \return A reference to this term.
+   */
+  Term & operator=( const Term & term ) = default;
+  /**
+   * \brief Move assignment.
+   * \param[in] term The original.
+   * \return A reference to this term.
+   */
+  Term & operator=( Term && term ) = default;
 
   // output
   /**
@@ -144,6 +173,11 @@ public:
    * \return A reference to the dominant coefficient.
    */
   const Coefficient & coefficient() const;
+  /**
+   * \brief Get the ring of this term.
+   * \return The ring (number of variables, order, and fields).
+   */
+  const Ring & ring() const;
   /**
    * \brief Reset the monomial order
    * \param[in] newOrder The new monomial order for this term.
@@ -241,6 +275,19 @@ public:
    * \return Are these terms similar?
    */
   bool isSimilar( const Term & operant ) const;
+  /**
+   * \brief Check if this term is identical to another one, i.e. has the same
+   *        ring, monomial and dominant index, and equal coefficients in all
+   *        fields (not just in the dominant one like operator==).
+   * \return Are these terms identical?
+   */
+  bool isIdentical( const Term & operant ) const;
+  /**
+   * \brief A hash of the monomial and the coefficients (identical terms have
+   *        the same hash).
+   * \return The hash.
+   */
+  size_t hash() const;
   
   // handy operations
   
@@ -268,12 +315,25 @@ public:
 	
 private:
 
-  /** The coefficients of this term */
-  mutable std::vector<Coefficient> _coefficients;
+  /** The coefficients of this term (stored inline) */
+  mutable CoefficientList _coefficients;
   /** The currently dominant coefficient */
   mutable int _dominantIndex;
   /** The monomial of this term */
   Monomial _monomial;
+  /** The ring of this term (shared by all terms of the same kind) */
+  const Ring * _ring;
+  
+  /**
+   * \brief Constructor for a term of a known ring (skips the lookup).
+   * \param[in] coefficients The coefficients.
+   * \param[in] monomial The monomial.
+   * \param[in] ring The ring of the coefficients and the monomial.
+   */
+  Term(
+      CoefficientList && coefficients,
+      const Monomial & monomial,
+      const Ring * ring );
 
   /**
    * \brief Check if this and another term have opposing multiplicity.
@@ -353,11 +413,32 @@ public:
   static Term randZ( size_t dimensions, Monomial::Order order = Monomial::GREVLEX )
   { return Term( Coefficient(fields::Field::Zp,true), Monomial(dimensions,order) ); };
   
+  // rand terms drawn from a given context
+  static Term randR( size_t dimensions, GenerationContext & context, Monomial::Order order = Monomial::GREVLEX )
+  { return Term( Coefficient(fields::Field::R, true, context), Monomial(dimensions,order) ); };
+  static Term randQ( size_t dimensions, GenerationContext & context, Monomial::Order order = Monomial::GREVLEX )
+  { return Term( Coefficient(fields::Field::Q, true, context), Monomial(dimensions,order) ); };
+  static Term randZ( size_t dimensions, GenerationContext & context, Monomial::Order order = Monomial::GREVLEX )
+  { return Term( Coefficient(fields::Field::Zp, true, context), Monomial(dimensions,order) ); };
+  
   // symbolic terms
   static Term S( const std::string & name, size_t dimensions, Monomial::Order order = Monomial::GREVLEX )
   { return Term( Coefficient(name), Monomial(dimensions,order) ); };
   static Term SrandZ( const std::string & name, size_t dimensions, Monomial::Order order = Monomial::GREVLEX )
   { return Term( Coefficient(name), Coefficient( fields::Field::Zp, true ), Monomial(dimensions,order) ); };
+  static Term SrandZ( const std::string & name, size_t dimensions, GenerationContext & context, Monomial::Order order = Monomial::GREVLEX )
+  { return Term( Coefficient(name), Coefficient( fields::Field::Zp, true, context ), Monomial(dimensions,order) ); };
+};
+
+/**
+ * Comparator "bigger" for the terms of a polynomial. Terms of the same ring
+ * are compared with the inlined comparison of their order (see
+ * MonomialOrder.hpp), which is resolved once per comparison. Other terms fall
+ * back to Term::operator> (which reports mixed orders).
+ */
+struct TermGreater
+{
+  bool operator()( const Term & t1, const Term & t2 ) const;
 };
 
 }
@@ -31,6 +31,8 @@
 #include <string>
 #include <iostream>
 
+#include <polyjam/core/Counters.hpp>
+
 
 /**
  * \brief The namespace of this library.
@@ -66,7 +68,7 @@ public:
    * \brief Default constructor.
    * \param[in] kind The kind of the field.
    */
-  Field( Kind kind ) : _kind(kind) {};
+  Field( Kind kind ) : _kind(kind) { POLYJAM_COUNT(fieldAllocations); };
   /**
    * \brief Destructor.
    */
@@ -28,6 +28,7 @@
 
 #include <polyjam/fields/Field.hpp>
 #include <stdint.h>
+#include <random>
 
 /**
  * \brief The namespace of this library.
@@ -50,10 +51,10 @@ class Q : public Field
 public:
 
   /**
-   * \brief Constructor for a zero or random number.
-   * \param[in] random Set this to a random number?
+   * \brief Constructor for a random number.
+   * \param[in] generator The random number generator to draw from.
    */
-  Q( bool random = false );
+  Q( std::mt19937 & generator );
   /**
    * \brief Constructor.
    * \param[in] numerator Initial numerator value.
@@ -27,6 +27,7 @@
 #define POLYJAM_FIELDS_R_HPP_
 
 #include <polyjam/fields/Field.hpp>
+#include <random>
 
 /**
  * \brief The namespace of this library.
@@ -49,10 +50,10 @@ class R : public Field
 public:
 
   /**
-   * \brief Constructor for a zero or random number.
-   * \param[in] random Set this to a random number?
+   * \brief Constructor for a random number.
+   * \param[in] generator The random number generator to draw from.
    */
-  R( bool random = false );
+  R( std::mt19937 & generator );
   /**
    * \brief Constructor.
    * \param[in] value The initial value.
@@ -27,6 +27,7 @@
 #define POLYJAM_FIELDS_ZP_HPP_
 
 #include <polyjam/fields/Field.hpp>
+#include <random>
 
 #define DEFAULT_CHARACTERISTIC 30097
 
@@ -51,11 +52,11 @@ class Zp : public Field
 public:
 
   /**
-   * \brief Constructor for zero or random member.
-   * \param[in] random Sets this number to a random prime field member.
+   * \brief Constructor for a random member.
+   * \param[in] generator The random number generator to draw from.
    * \param[in] prime The characteristic of the prime field.
    */
-  Zp( bool random = false, unsigned int characteristic = DEFAULT_CHARACTERISTIC );
+  Zp( std::mt19937 & generator, unsigned int characteristic = DEFAULT_CHARACTERISTIC );
   /**
    * \brief Constructor.
    * \param[in] value The initial value of the prime-field member.
@@ -87,6 +88,11 @@ public:
    * \return The characteristic.
    */
   unsigned int characteristic() const;
+  /**
+   * \brief Get the value of this prime field member.
+   * \return The value (between 0 and characteristic-1).
+   */
+  unsigned int value() const;
 
   // Get constants from this field
   
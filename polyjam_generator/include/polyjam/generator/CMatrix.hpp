@@ -27,6 +27,7 @@
 #include <list>
 
 #include <polyjam/core/Poly.hpp>
+#include <polyjam/core/MonomialTable.hpp>
 
 
 /**
@@ -57,11 +58,12 @@ public:
   typedef std::pair<int,core::Monomial> eq_t;
   typedef std::vector<eq_t> eqs_t;
   
-  //constructors
+  //constructors (the expanded ones can share a table of monomials of the same
+  //system, which caches the products with the expanders and the ranks)
   CMatrix( const polynomials_t & polynomials );
-  CMatrix( const polynomials_t & polynomials, const eqs_t & equations );
+  CMatrix( const polynomials_t & polynomials, const eqs_t & equations, core::MonomialTable * table = NULL );
   CMatrix( const polynomials_t & polynomials, const monomials_t & order );
-  CMatrix( const polynomials_t & polynomials, const monomials_t & order, const eqs_t & equations );
+  CMatrix( const polynomials_t & polynomials, const monomials_t & order, const eqs_t & equations, core::MonomialTable * table = NULL );
   
   //destructor
   virtual ~CMatrix();
@@ -72,6 +74,8 @@ public:
   //accessors
   size_t rows();
   size_t cols();
+  size_t nonzeros();
+  size_t operations(); //the number of field operations of the last reduction
   core::Coefficient operator()( size_t row, size_t col );
   
   CMatrix subMatrix( const std::list<int> & rows );
@@ -79,9 +83,11 @@ public:
   core::Poly getPolynomial( int row );
   core::Poly getSymbolicPolynomial( int row, const std::string & matrixName ); 
   core::Poly getSymbolicPolynomial2( int row );
+  core::Poly getSymbolicPolynomial2( int row, const std::vector<int> & columnLabels );
   polynomials_t getPolynomials();
   polynomials_t getSymbolicPolynomials( const std::string & matrixName );
   polynomials_t getSymbolicPolynomials2();
+  polynomials_t getSymbolicPolynomials2( const std::vector<int> & columnLabels );
   
   //verifiers
   bool contains( const polynomials_t & polynomials );
@@ -93,9 +99,11 @@ private:
 
   void fillMonomials( const polynomials_t & polynomials );
   void fillMatrix( const polynomials_t & polynomials, bool quickOrdering = true );
+  void fillExpanded( const polynomials_t & polynomials, const eqs_t & equations, bool collectMonomials, core::MonomialTable * table );
 
   cmatrix_t _matrix;
   monomials_t _monomials;
+  size_t _operations;
 };
 
 }
@@ -0,0 +1,134 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#ifndef POLYJAM_GENERATOR_GROEBNER_HPP_
+#define POLYJAM_GENERATOR_GROEBNER_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <vector>
+#include <utility>
+#include <string>
+
+#include <polyjam/core/Poly.hpp>
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+namespace generator
+{
+
+/**
+ * The class computes a Groebner basis of a system of Zp polynomials
+ * (Buchberger's algorithm with the sugar strategy and the Gebauer-Moeller
+ * criteria, GRevLex order), and derives the dimension and degree of the
+ * ideal as well as the standard monomials. It replaces the analysis that
+ * used to be done by Macaulay2.
+ */
+class Groebner
+{
+public:
+  /** A monomial given by its exponents */
+  typedef std::vector<unsigned int> exponents_t;
+  /** A term given by its monomial and its value in Zp */
+  typedef std::pair<exponents_t,unsigned int> term_t;
+  /** A polynomial, the terms are sorted in descending GRevLex order */
+  typedef std::vector<term_t> poly_t;
+
+  Groebner();
+  virtual ~Groebner();
+
+  // Make sure the dominant index is set correctly before adding these polynomials
+  void addPoly( const core::Poly & poly );
+
+  /**
+   * \brief A canonical textual form of the added system (monic equations in
+   *        sorted order), two systems with the same form define the same ideal.
+   * \return The canonical form.
+   */
+  std::string canonicalForm() const;
+
+  /**
+   * \brief Compute the Groebner basis and analyse the ideal.
+   * \return False if there are no valid equations.
+   */
+  bool compute();
+
+  /**
+   * \brief The Krull dimension of the ideal (-1 if the ideal is the whole ring).
+   * \return Dimension.
+   */
+  int dimension() const;
+  /**
+   * \brief The degree of the ideal, i.e. the number of standard monomials
+   *        (only available if the ideal is zero-dimensional, -1 otherwise).
+   * \return Degree.
+   */
+  int degree() const;
+  /**
+   * \brief The standard monomials (only if the ideal is zero-dimensional).
+   * \return The monomials that are not divisible by any leading monomial.
+   */
+  const std::vector<core::Monomial> & standardMonomials() const;
+  /**
+   * \brief The leading monomials of the (minimal) Groebner basis.
+   * \return The leading monomials.
+   */
+  std::vector<core::Monomial> leadingMonomials() const;
+
+private:
+  size_t _numberVariables;
+  unsigned int _characteristic;
+
+  std::vector<poly_t> _equations;
+  std::vector<poly_t> _basis;
+  std::vector<unsigned int> _sugar;
+  std::vector<bool> _active;
+
+  int _dimension;
+  int _degree;
+  std::vector<core::Monomial> _standardMonomials;
+
+  // field operations in Zp
+  unsigned int multiply( unsigned int a, unsigned int b ) const;
+  unsigned int inverse( unsigned int a ) const;
+
+  // polynomial operations
+  void makeMonic( poly_t & poly ) const;
+  void subtractMultiple( poly_t & poly, unsigned int factor, const exponents_t & multiplier, const poly_t & reducer ) const;
+  int findReducer( const exponents_t & monomial ) const;
+  void reduce( poly_t & poly ) const;
+  poly_t sPolynomial( size_t i, size_t j ) const;
+
+  // bookkeeping of the critical pairs
+  void update( std::vector< std::pair<size_t,size_t> > & pairs, size_t h );
+
+  // analysis of the result
+  void analyse();
+};
+
+}
+}
+
+#endif /* POLYJAM_GENERATOR_GROEBNER_HPP_ */
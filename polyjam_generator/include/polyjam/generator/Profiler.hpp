@@ -0,0 +1,127 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#ifndef POLYJAM_GENERATOR_PROFILER_HPP_
+#define POLYJAM_GENERATOR_PROFILER_HPP_
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <polyjam/core/Counters.hpp>
+#include <polyjam/generator/CMatrix.hpp>
+
+/**
+ * \brief The namespace of this library.
+ */
+namespace polyjam
+{
+
+namespace generator
+{
+
+/**
+ * The class records the phases of a solver generation (wall and CPU time,
+ * peak memory, plus arbitrary values such as matrix dimensions and operation
+ * counts), and exports them as JSON or as a Chrome trace (chrome://tracing).
+ * Phases may be nested. If the library is compiled with POLYJAM_COUNTERS, the
+ * counts of the core algebra (see core::Counters) are added to each phase.
+ */
+class Profiler
+{
+public:
+  /** A named value recorded in a phase */
+  typedef std::pair<std::string,double> value_t;
+
+  /** A finished or running phase */
+  struct Phase
+  {
+    std::string name;
+    size_t depth;
+    double start;   //wall time since the creation of the profiler [ms]
+    double wall;    //[ms]
+    double cpu;     //[ms]
+    long peakRss;   //peak resident set size at the end of the phase [kB]
+    std::vector<value_t> values;
+  };
+
+  Profiler();
+  virtual ~Profiler();
+
+  /**
+   * \brief Start a new phase (inside the current one, if any).
+   * \param[in] name The name of the phase.
+   */
+  void begin( const std::string & name );
+  /**
+   * \brief Finish the innermost running phase.
+   */
+  void end();
+
+  /**
+   * \brief Record a value in the innermost running phase.
+   * \param[in] key The name of the value.
+   * \param[in] value The value.
+   */
+  void record( const std::string & key, double value );
+  /**
+   * \brief Record the dimensions and nonzeros of a matrix, and the number of
+   *        field operations of its last reduction.
+   * \param[in] prefix The prefix of the names of the values.
+   * \param[in] matrix The matrix.
+   */
+  void record( const std::string & prefix, CMatrix & matrix );
+
+  /**
+   * \brief The phases recorded so far, in the order they started.
+   * \return The phases.
+   */
+  const std::vector<Phase> & phases() const;
+
+  /**
+   * \brief Save the phases as JSON.
+   * \param[in] fileName The name of the file.
+   */
+  void saveJson( const std::string & fileName ) const;
+  /**
+   * \brief Save the phases in the Chrome trace event format.
+   * \param[in] fileName The name of the file.
+   */
+  void saveTrace( const std::string & fileName ) const;
+
+private:
+  double wallTime() const;
+  double cpuTime() const;
+  long peakRss() const;
+
+  double _origin;
+  std::vector<Phase> _phases;
+  std::vector<size_t> _running;
+  std::vector<double> _cpuStart;
+  std::vector<core::Counters> _countersStart;
+};
+
+}
+}
+
+#endif /* POLYJAM_GENERATOR_PROFILER_HPP_ */
@@ -25,9 +25,11 @@
 #include <stdio.h>
 #include <vector>
 #include <list>
+#include <string>
 
 #include <polyjam/core/Poly.hpp>
 #include <polyjam/generator/CMatrix.hpp>
+#include <polyjam/generator/Profiler.hpp>
 
 
 /**
@@ -49,6 +51,17 @@ namespace generator
 namespace methods
 {
 
+//the state of the pruning loop in buildTemplate
+struct PruningState
+{
+  std::list<core::Poly*> polynomials;     //the pre-eliminated polynomials the template is built from
+  std::list<core::Poly*> goodPolynomials; //the polynomials needed for the Action matrix
+  std::list<int> usedEquations;
+  size_t position;                        //the position of the iterator in usedEquations
+  int toRemove;
+  int originalNumber;
+};
+
 CMatrix experiment(
     const std::list<core::Poly*> & polynomials,
     const std::vector<core::Monomial> & expanders,
@@ -63,6 +76,15 @@ int automaticDegreeFinder(
     bool visualization = false,
     bool consolePrint = false,
     bool evenOnly = false );
+
+bool searchTemplate(
+    const std::list<core::Poly*> & polynomials,
+    const std::vector<core::Monomial> & expanders,
+    const std::vector<core::Monomial> & baseMonomials,
+    int maxDegree,
+    core::Monomial & multiplier,
+    int & expanderDegree,
+    bool consolePrint = true );
     
 void generate(
     const std::list<core::Poly*> & polynomials,
@@ -75,14 +97,64 @@ void generate(
     const std::string & solverName,
     const std::string & parameters,
     const std::string & save_path,
+    const core::GenerationContext & context,
     bool visualize = false );
 
+void generateBenchmark(
+    CMatrix & symMatrix,
+    const std::string & benchmarkFile,
+    const std::string & solverName,
+    const std::string & parameters,
+    int unknowns );
+
+void buildTemplate(
+    const std::list<core::Poly*> & zp_polynomials,
+    const std::vector<core::Monomial> & expanders,
+    const std::vector<core::Monomial> & baseMonomials,
+    const core::Monomial & multiplier,
+    CMatrix::monomials_t & finalMonomials,
+    CMatrix::eqs_t & finalReorderedEquations,
+    bool visualize = false,
+    bool consolePrint = true,
+    const std::string & checkpointFile = std::string(),
+    const std::string & checkpointKey = std::string(),
+    int checkpointInterval = 0,
+    Profiler * profiler = NULL );
+
 void generateSuperlinearExpanders( std::vector<core::Monomial> & expanders, int maxDegree );
 
 void generateEvendegreeExpanders( const std::vector<core::Monomial> & originalMonomials, std::vector<core::Monomial> & expanders, int maxDegree );
 
 CMatrix::eqs_t transformExpanders(
     const std::vector<core::Monomial> & expanders, size_t polynomials );
+
+std::string canonicalForm( const std::list<core::Poly*> & polynomials );
+
+std::string hashString( const std::string & input );
+
+bool loadTemplate(
+    const std::string & fileName,
+    const std::string & key,
+    const std::vector<int> & M1columns,
+    CMatrix::monomials_t & finalMonomials,
+    CMatrix::eqs_t & finalReorderedEquations );
+
+void saveTemplate(
+    const std::string & fileName,
+    const std::string & key,
+    const std::vector<int> & M1columns,
+    const CMatrix::monomials_t & finalMonomials,
+    const CMatrix::eqs_t & finalReorderedEquations );
+
+bool loadCheckpoint(
+    const std::string & fileName,
+    const std::string & key,
+    PruningState & state );
+
+void saveCheckpoint(
+    const std::string & fileName,
+    const std::string & key,
+    const PruningState & state );
     
 }
 }
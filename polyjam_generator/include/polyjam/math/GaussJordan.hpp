@@ -182,7 +182,8 @@ template<typename COEFFICIENT>
 void
 gaussReduction(
     std::vector<std::vector<COEFFICIENT>*> & matrix,
-    bool continuousVisualization = false )
+    bool continuousVisualization = false,
+    size_t * operations = NULL )
 {
   //define some types to make life easier
   typedef COEFFICIENT coefficient_t;
@@ -259,9 +260,12 @@ gaussReduction(
     
     //first divide all coefficients by the leading coefficient
     int col = currentIndentation;
-    coefficient_t leadingCoefficient = (*(matrix[frontRow]))[col] + zero; //the +zero is important! It causes the coefficient to be copied!
-    (*(matrix[frontRow]))[col] = one + zero;
+    //coefficients are copy-on-write, so plain copies are safe to keep here
+    coefficient_t leadingCoefficient = (*(matrix[frontRow]))[col];
+    (*(matrix[frontRow]))[col] = one;
     coefficient_t leadingCoefficient_inv = (*(matrix[frontRow]))[col] / leadingCoefficient;
+    if( operations != NULL )
+      (*operations) += cols - col;
     ++col;
     while( col < cols )
     {
@@ -287,10 +291,13 @@ gaussReduction(
     while( row < rows )
     {
       col = currentIndentation;
-      coefficient_t leadingCoefficient = (*(matrix[row]))[col] + zero;
+      coefficient_t leadingCoefficient = (*(matrix[row]))[col];
       
       if( leadingCoefficient != zero )
       {
+        //one multiplication and one subtraction per element
+        if( operations != NULL )
+          (*operations) += 2 * nonzeroIdx.size();
         for( int col = 0; col < (int) nonzeroIdx.size(); col++ )
         {
           (*(matrix[row]))[nonzeroIdx[col]] -= leadingCoefficient * ((*(matrix[frontRow]))[nonzeroIdx[col]]);
@@ -367,12 +374,14 @@ gaussReduction(
       //working column
       
       //now get the leading coefficient
-      coefficient_t leadingCoefficient = (*(matrix[row]))[indentations] + zero;
+      coefficient_t leadingCoefficient = (*(matrix[row]))[indentations];
       
       //Now iterator until the end, and subtract each time the multiplied
       //front-row
       if( leadingCoefficient != zero )
       {        
+        if( operations != NULL )
+          (*operations) += 2 * nonzeroIdx.size();
         for( int col = 0; col < (int) nonzeroIdx.size(); col++ )
           (*(matrix[row]))[nonzeroIdx[col]] -= leadingCoefficient * (*(matrix[frontRow]))[nonzeroIdx[col]];
       }
@@ -22,11 +22,14 @@
 #include <stdio.h>
 #include <iostream>
 #include <sstream>
+#include <functional>
 
 #include <polyjam/core/Poly.hpp>
 #include <polyjam/core/PolyMatrix.hpp>
+#include <polyjam/core/PolyCache.hpp>
 #include <polyjam/generator/methods.hpp>
 #include <polyjam/generator/ExportMacaulay.hpp>
+#include <polyjam/generator/Groebner.hpp>
 
 using namespace std;
 using namespace polyjam;
@@ -41,18 +44,42 @@ namespace polyjam
   void execGenerator( list<Poly*> & eqs, list<Poly*> & eqs_sym, const string & solverName, const string & parameters, bool visualize = false );
   void execGenerator( list<Poly*> & eqs, const string & solverName, const string & suffix, const string & parameters, bool visualize = false );
   void execGenerator( list<Poly*> & eqs, list<Poly*> & eqs_sym, const string & solverName, const string & suffix, const string & parameters, bool visualize = false );
+  void execGenerator( GenerationContext & context, list<Poly*> & eqs, list<Poly*> & eqs_sym, const string & solverName, const string & suffix, const string & parameters, bool visualize = false );
 
   void execGeneratorSym( list<Poly*> & eqs, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & parameters, bool visualize = false );
   void execGeneratorSym( list<Poly*> & eqs, list<Poly*> & eqs_sym, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & parameters, bool visualize = false );
   void execGeneratorSym( list<Poly*> & eqs, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & suffix, const string & parameters, bool visualize = false );
   void execGeneratorSym( list<Poly*> & eqs, list<Poly*> & eqs_sym, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & suffix, const string & parameters, bool visualize = false );
+  void execGeneratorSym( GenerationContext & context, list<Poly*> & eqs, list<Poly*> & eqs_sym, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & suffix, const string & parameters, bool visualize = false );
 
   //The following function is used internally and for actual solver generation
-  void execGeneratorInternal( bool even, list<Poly*> & eqs, list<Poly*> & eqs_sym, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & suffix, const string & parameters, bool visualize = false );
+  void execGeneratorInternal( GenerationContext & context, bool even, list<Poly*> & eqs, list<Poly*> & eqs_sym, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & suffix, const string & parameters, bool visualize = false );
+
+  //The following is a batch of generations that are run concurrently, each one in a process of its own
+  //(with the paths and options of the given context, and a log per job in the logs folder of the workspace)
+  struct GenerationJob
+  {
+    string solverName;
+    string suffix;
+    string parameters;
+    //fills in the equations of the problem (with a symbolic and a Zp coefficient in each term, see splitPolyLists)
+    std::function<void( GenerationContext & context, list<Poly*> & eqs )> equations;
+    //if given, the solver is generated with execGeneratorSym
+    std::vector<Monomial> baseMonomials;
+    int expanderDegree;
+
+    GenerationJob();
+  };
+  //returns the number of jobs that failed, numberWorkers = 0 uses all cores
+  int execBatch( const vector<GenerationJob> & jobs, GenerationContext & context, int numberWorkers = 0 );
 
   //The following function is to split up the list of polynomials into a symbolic and a non-symbolic one
   void splitPolyLists( list<Poly*> & eqs, list<Poly*> & eqs_zp, list<Poly*> & eqs_sym );
 
+  //The following functions are for caching the analysis of the ideal (keyed by the hash of the canonical system)
+  bool loadIdealAnalysis( const string & fileName, const string & canonicalSystem, int & dim, vector<Monomial> & baseMonomials );
+  void saveIdealAnalysis( const string & fileName, const string & canonicalSystem, int dim, const vector<Monomial> & baseMonomials );
+
   //The following functions are for interaction with Macaulay and interpretation of the result
   string exec( const char * cmd );
   void extractMonomials( const string & input, vector<Monomial> & baseMonomials, size_t nu );
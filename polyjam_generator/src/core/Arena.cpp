@@ -0,0 +1,145 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#include <polyjam/core/Arena.hpp>
+#include <new>
+
+namespace
+{
+
+//the arena of the innermost scope of each thread
+thread_local polyjam::core::Arena * currentArena = NULL;
+
+}
+
+polyjam::core::Arena::Scope::Scope() :
+    _arena(new Arena()),
+    _previous(currentArena)
+{
+  currentArena = _arena;
+}
+
+polyjam::core::Arena::Scope::~Scope()
+{
+  currentArena = _previous;
+  _arena->close();
+}
+
+void *
+polyjam::core::Arena::allocate( size_t size )
+{
+  size_t sizeClass = (size + GRANULARITY - 1) / GRANULARITY;
+  if( currentArena != NULL && sizeClass < NUMBER_SIZE_CLASSES )
+    return currentArena->get(sizeClass);
+  
+  Header * header = (Header *) ::operator new( sizeof(Header) + size );
+  header->arena = NULL;
+  header->sizeClass = sizeClass;
+  return header + 1;
+}
+
+void
+polyjam::core::Arena::deallocate( void * block )
+{
+  Header * header = ((Header *) block) - 1;
+  if( header->arena == NULL )
+    ::operator delete(header);
+  else
+    header->arena->put(header);
+}
+
+polyjam::core::Arena::Arena() :
+    _position(NULL),
+    _end(NULL),
+    _used(0),
+    _closed(false)
+{
+  for( size_t i = 0; i < NUMBER_SIZE_CLASSES; i++ )
+    _free[i] = NULL;
+}
+
+polyjam::core::Arena::~Arena()
+{
+  for( size_t i = 0; i < _chunks.size(); i++ )
+    ::operator delete(_chunks[i]);
+}
+
+void *
+polyjam::core::Arena::get( size_t sizeClass )
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _used++;
+  
+  //reuse a freed block of the same size if possible
+  Header * header = NULL;
+  if( _free[sizeClass] != NULL )
+  {
+    header = (Header *) _free[sizeClass];
+    _free[sizeClass] = _free[sizeClass]->next;
+  }
+  else
+  {
+    size_t blockSize = (sizeClass + 1) * GRANULARITY;
+    if( _position == NULL || _position + blockSize > _end )
+    {
+      _chunks.push_back( (char *) ::operator new(CHUNK_SIZE) );
+      _position = _chunks.back();
+      _end = _position + CHUNK_SIZE;
+    }
+    header = (Header *) _position;
+    _position += blockSize;
+  }
+  
+  header->arena = this;
+  header->sizeClass = sizeClass;
+  return header + 1;
+}
+
+void
+polyjam::core::Arena::put( Header * header )
+{
+  bool release = false;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    FreeBlock * block = (FreeBlock *) header;
+    block->next = _free[header->sizeClass];
+    _free[header->sizeClass] = block;
+    _used--;
+    release = _closed && _used == 0;
+  }
+  
+  //the last block of a closed arena gives back all chunks
+  if( release )
+    delete this;
+}
+
+void
+polyjam::core::Arena::close()
+{
+  bool release = false;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _closed = true;
+    release = _used == 0;
+  }
+  
+  if( release )
+    delete this;
+}
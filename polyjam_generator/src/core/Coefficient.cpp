@@ -26,186 +26,288 @@
 #include <polyjam/fields/Sym.hpp>
 
 #include <iostream>
+#include <new>
+#include <functional>
 
 using namespace std;
 
 // Constructors
 
-polyjam::core::Coefficient::Coefficient( fields::Field::Kind kind, bool random )
+polyjam::core::Coefficient::Coefficient( fields::Field::Kind kind, bool random ) :
+    Coefficient(kind,random,GenerationContext::current())
+{}
+
+polyjam::core::Coefficient::Coefficient(
+    fields::Field::Kind kind, bool random, GenerationContext & context ) :
+    _value(NULL)
 {
-  fields::Field * newField = NULL;
-  
   switch(kind)
   {
     case fields::Field::R:
     {
-      newField = new fields::R(random);
+      if(random)
+        _value = new (&_local.r) fields::R(context.generator());
+      else
+        _value = new (&_local.r) fields::R(0.0);
       break;
     }
     case fields::Field::Q:
     {
-      newField = new fields::Q(random);
+      if(random)
+        _value = new (&_local.q) fields::Q(context.generator());
+      else
+        _value = new (&_local.q) fields::Q(0);
       break;
     }
     case fields::Field::Zp:
     {
-      newField = new fields::Zp(random);
+      if(random)
+        _value = new (&_local.zp) fields::Zp(context.generator(),context.characteristic());
+      else
+        _value = new (&_local.zp) fields::Zp(0,context.characteristic());
       break;
     }
     case fields::Field::Sym:
     {
-      newField = new fields::Sym();
+      _field = FieldPtr(new fields::Sym());
+      _value = _field.get();
       break;
     }
     default:
       break;
   }
-  
-  _field = FieldPtr(newField);
 }
 
 polyjam::core::Coefficient::Coefficient(
     double value ) :
-    _field(new fields::R(value))
+    _value(new (&_local.r) fields::R(value))
 {}
 
 polyjam::core::Coefficient::Coefficient(
     int numerator, unsigned int denominator ) :
-    _field(new fields::Q(numerator,denominator))
+    _value(new (&_local.q) fields::Q(numerator,denominator))
 {}
 
 polyjam::core::Coefficient::Coefficient(
-    int constant, fields::Field::Kind kind )
+    int constant, fields::Field::Kind kind ) :
+    _value(NULL)
 {
-  fields::Field * newField = NULL;
-  
   switch(kind)
   {
     case fields::Field::R:
     {
-      newField = new fields::R((double) constant);
+      _value = new (&_local.r) fields::R((double) constant);
       break;
     }
     case fields::Field::Q:
     {
-      newField = new fields::Q(constant);
+      _value = new (&_local.q) fields::Q(constant);
       break;
     }
     case fields::Field::Zp:
     {
-      newField = new fields::Zp(constant);
+      _value = new (&_local.zp) fields::Zp(constant,GenerationContext::current().characteristic());
       break;
     }
     case fields::Field::Sym:
     {
-      newField = new fields::Sym(constant);
+      _field = FieldPtr(new fields::Sym(constant));
+      _value = _field.get();
       break;
     }
     default:
       break;
   }
-  
-  _field = FieldPtr(newField);
 }
 
 polyjam::core::Coefficient::Coefficient( const std::string & name ) :
     _field(new fields::Sym(name))
-{}
+{
+  _value = _field.get();
+}
 
 polyjam::core::Coefficient::Coefficient( const char * name ) :
     _field(new fields::Sym(name))
-{}
+{
+  _value = _field.get();
+}
 
 polyjam::core::Coefficient::Coefficient( fields::Field * field ) :
-    _field(field)
-{}
+    _value(NULL)
+{
+  if( field->kind() == fields::Field::Sym )
+  {
+    _field = FieldPtr(field);
+    _value = field;
+    return;
+  }
+  
+  setValue(field);
+  delete field;
+}
+
+polyjam::core::Coefficient::Coefficient( const fields::Field & field ) :
+    _value(NULL)
+{
+  if( field.kind() == fields::Field::Sym )
+  {
+    _field = FieldPtr(new fields::Sym(&field));
+    _value = _field.get();
+    return;
+  }
+  
+  setValue(&field);
+}
 
 // Destructor
 
 polyjam::core::Coefficient::~Coefficient()
-{}
+{
+  release();
+}
 
-// deep copy stuff
+// lazy copy and move
 
-polyjam::core::Coefficient
-polyjam::core::Coefficient::clone() const
+polyjam::core::Coefficient::Coefficient( const Coefficient & coefficient ) :
+    _value(NULL)
+{
+  assign(coefficient);
+}
+
+polyjam::core::Coefficient::Coefficient( Coefficient && coefficient ) :
+    _value(NULL)
 {
-  fields::Field * newField = NULL;
+  if( coefficient.isLocal() )
+  {
+    setValue(coefficient._value);
+    return;
+  }
   
-  switch( kind() )
+  _field = std::move(coefficient._field);
+  _value = _field.get();
+  coefficient._value = NULL;
+}
+
+polyjam::core::Coefficient &
+polyjam::core::Coefficient::operator=( const Coefficient & coefficient )
+{
+  if( this != &coefficient )
   {
-    case fields::Field::R:
-    {
-      newField = new fields::R(_field.get());
-      break;
-    }
-    case fields::Field::Q:
-    {
-      newField = new fields::Q(_field.get());
-      break;
-    }
-    case fields::Field::Zp:
-    {
-      newField = new fields::Zp(_field.get());
-      break;
-    }
-    case fields::Field::Sym:
-    {
-      newField = new fields::Sym(_field.get());
-      break;
-    }
-    default:
-      break;
+    release();
+    assign(coefficient);
   }
+  return (*this);
+}
+
+polyjam::core::Coefficient &
+polyjam::core::Coefficient::operator=( Coefficient && coefficient )
+{
+  if( this == &coefficient )
+    return (*this);
   
-  return Coefficient(newField);
+  release();
+  if( coefficient.isLocal() )
+  {
+    setValue(coefficient._value);
+    return (*this);
+  }
+  
+  _field = std::move(coefficient._field);
+  _value = _field.get();
+  coefficient._value = NULL;
+  return (*this);
+}
+
+bool
+polyjam::core::Coefficient::isLocal() const
+{
+  return _value != NULL && _value != _field.get();
 }
 
 void
-polyjam::core::Coefficient::copy( const Coefficient & coefficient )
+polyjam::core::Coefficient::setValue( const fields::Field * field )
 {
-  fields::Field * newField = NULL;
-  
-  switch( coefficient.kind() )
+  switch( field->kind() )
   {
     case fields::Field::R:
     {
-      newField = new fields::R(coefficient._field.get());
+      _value = new (&_local.r) fields::R(field);
       break;
     }
     case fields::Field::Q:
     {
-      newField = new fields::Q(coefficient._field.get());
+      _value = new (&_local.q) fields::Q(field);
       break;
     }
     case fields::Field::Zp:
     {
-      newField = new fields::Zp(coefficient._field.get());
+      _value = new (&_local.zp) fields::Zp(field);
       break;
     }
     case fields::Field::Sym:
     {
-      newField = new fields::Sym(coefficient._field.get());
+      _field = FieldPtr(new fields::Sym(field));
+      _value = _field.get();
       break;
     }
     default:
       break;
   }
+}
+
+void
+polyjam::core::Coefficient::release()
+{
+  if( isLocal() )
+    _value->~Field();
+  _field.reset();
+  _value = NULL;
+}
+
+void
+polyjam::core::Coefficient::assign( const Coefficient & coefficient )
+{
+  if( coefficient.isLocal() )
+  {
+    setValue(coefficient._value);
+    return;
+  }
   
-  _field = FieldPtr(newField);
+  _field = coefficient._field;
+  _value = _field.get();
+}
+
+// deep copy stuff
+
+polyjam::core::Coefficient
+polyjam::core::Coefficient::clone() const
+{
+  POLYJAM_COUNT(coefficientClones);
+  return Coefficient(*_value);
+}
+
+void
+polyjam::core::Coefficient::copy( const Coefficient & coefficient )
+{
+  POLYJAM_COUNT(coefficientClones);
+  if( this == &coefficient && isLocal() )
+    return;
+  
+  Coefficient newClone(*coefficient._value);
+  (*this) = std::move(newClone);
 }
 
 // output
 void
 polyjam::core::Coefficient::print() const
 {
-  _field->print();
+  _value->print();
 }
 
 string
 polyjam::core::Coefficient::getString( bool c_version ) const
 {
-  return _field->getString( c_version );
+  return _value->getString( c_version );
 }
 
 string
@@ -217,26 +319,46 @@ polyjam::core::Coefficient::getStringSpecial( bool c_version ) const
     return 0;
   }
 
-  fields::Sym * sy = (fields::Sym *) _field.get();
+  fields::Sym * sy = (fields::Sym *) _value;
   return sy->getStringSpecial( c_version );
 }
 
 polyjam::fields::Field::Kind
 polyjam::core::Coefficient::kind() const
 {
-  return _field->kind();
+  return _value->kind();
 }
 
 polyjam::core::Coefficient
 polyjam::core::Coefficient::zero() const
 {
-  return Coefficient(_field->zero());
+  switch( kind() )
+  {
+    case fields::Field::R:
+      return Coefficient(0.0);
+    case fields::Field::Q:
+      return Coefficient(0,1);
+    case fields::Field::Zp:
+      return Coefficient(fields::Zp(0,_local.zp.characteristic()));
+    default:
+      return Coefficient(_value->zero());
+  }
 }
 
 polyjam::core::Coefficient
 polyjam::core::Coefficient::one() const
 {
-  return Coefficient(_field->one());
+  switch( kind() )
+  {
+    case fields::Field::R:
+      return Coefficient(1.0);
+    case fields::Field::Q:
+      return Coefficient(1,1);
+    case fields::Field::Zp:
+      return Coefficient(fields::Zp(1,_local.zp.characteristic()));
+    default:
+      return Coefficient(_value->one());
+  }
 }
 
 unsigned int
@@ -248,10 +370,23 @@ polyjam::core::Coefficient::characteristic() const
     cout << " from non Zp coefficient." << endl;
     return 0;
   }
-  fields::Zp * zp = (fields::Zp *) _field.get();
+  fields::Zp * zp = (fields::Zp *) _value;
   return zp->characteristic();
 }
 
+unsigned int
+polyjam::core::Coefficient::zpValue() const
+{
+  if( kind() != fields::Field::Zp )
+  {
+    cout << "Error: cannot retrieve the value";
+    cout << " from non Zp coefficient." << endl;
+    return 0;
+  }
+  fields::Zp * zp = (fields::Zp *) _value;
+  return zp->value();
+}
+
 // standard operations
 
 polyjam::core::Coefficient
@@ -307,63 +442,76 @@ polyjam::core::Coefficient::operator/( const Coefficient & operant ) const
 polyjam::core::Coefficient &
 polyjam::core::Coefficient::negationInPlace()
 {
-  _field->negation();
+  detach();
+  _value->negation();
   return (*this);
 }
 
 polyjam::core::Coefficient &
 polyjam::core::Coefficient::inversionInPlace()
 {
-  _field->inversion();
+  detach();
+  _value->inversion();
   return (*this);
 }
 
 polyjam::core::Coefficient &
 polyjam::core::Coefficient::operator+=( const Coefficient & operant )
 {
-  _field->add(operant._field.get());
+  detach();
+  _value->add(operant._value);
   return (*this);
 }
 
 polyjam::core::Coefficient &
 polyjam::core::Coefficient::operator-=( const Coefficient & operant )
 {
-  _field->subtract(operant._field.get());
+  detach();
+  _value->subtract(operant._value);
   return (*this);
 }
 
 polyjam::core::Coefficient &
 polyjam::core::Coefficient::operator*=( const Coefficient & operant )
 {
-  _field->multiply(operant._field.get());
+  detach();
+  _value->multiply(operant._value);
   return (*this);
 }
 
 polyjam::core::Coefficient &
 polyjam::core::Coefficient::operator/=( const Coefficient & operant )
 {
-  _field->divide(operant._field.get());
+  detach();
+  _value->divide(operant._value);
   return (*this);
 }
 
+void
+polyjam::core::Coefficient::detach()
+{
+  if( !isLocal() && _field.use_count() > 1 )
+    copy(*this);
+}
+
 // comparisons
 
 bool
 polyjam::core::Coefficient::operator==( const Coefficient & operant ) const
 {
-  return _field->isEql(operant._field.get());
+  return _value->isEql(operant._value);
 }
 
 bool
 polyjam::core::Coefficient::operator!=( const Coefficient & operant ) const
 {
-  return !(_field->isEql(operant._field.get()));
+  return !(_value->isEql(operant._value));
 }
 
 bool
 polyjam::core::Coefficient::operator<=( const Coefficient & operant ) const
 {
-  int result = _field->compare(operant._field.get());
+  int result = _value->compare(operant._value);
   if( result <= 0 )
     return true;
   return false;
@@ -372,7 +520,7 @@ polyjam::core::Coefficient::operator<=( const Coefficient & operant ) const
 bool
 polyjam::core::Coefficient::operator>=( const Coefficient & operant ) const
 {
-  int result = _field->compare(operant._field.get());
+  int result = _value->compare(operant._value);
   if( result >= 0 )
     return true;
   return false;
@@ -381,7 +529,7 @@ polyjam::core::Coefficient::operator>=( const Coefficient & operant ) const
 bool
 polyjam::core::Coefficient::operator<( const Coefficient & operant ) const
 {
-  int result = _field->compare(operant._field.get());
+  int result = _value->compare(operant._value);
   if( result < 0 )
     return true;
   return false;
@@ -390,7 +538,7 @@ polyjam::core::Coefficient::operator<( const Coefficient & operant ) const
 bool
 polyjam::core::Coefficient::operator>( const Coefficient & operant ) const
 {
-  int result = _field->compare(operant._field.get());
+  int result = _value->compare(operant._value);
   if( result > 0 )
     return true;
   return false;
@@ -401,14 +549,14 @@ polyjam::core::Coefficient::operator>( const Coefficient & operant ) const
 polyjam::core::Coefficient &
 polyjam::core::Coefficient::setToZero()
 {
-  _field = FieldPtr(_field->zero());
+  (*this) = zero();
   return (*this);
 }
 
 polyjam::core::Coefficient &
 polyjam::core::Coefficient::setToOne()
 {
-  _field = FieldPtr(_field->one());
+  (*this) = one();
   return (*this);
 }
 
@@ -417,19 +565,20 @@ polyjam::core::Coefficient::setToOne()
 bool
 polyjam::core::Coefficient::isZero() const
 {
-  fields::Field* temp = _field->zero();
-  bool value = _field->isEql(temp);
-  delete temp;
-  return value;
-  //return _field->isEql(_field->zero());
+  return _value->isEql(zero()._value);
 }
 
 bool
 polyjam::core::Coefficient::isOne() const
 {
-  fields::Field* temp = _field->one();
-  bool value = _field->isEql(temp);
-  delete temp;
-  return value;
-  //return _field->isEql(_field->one());
+  return _value->isEql(one()._value);
+}
+
+size_t
+polyjam::core::Coefficient::hash() const
+{
+  //Zp is by far the most common case, the others go through their string
+  if( kind() == fields::Field::Zp )
+    return _local.zp.value();
+  return std::hash<std::string>()( getString(false) );
 }
@@ -0,0 +1,108 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#include <polyjam/core/Counters.hpp>
+#include <sstream>
+
+polyjam::core::Counters::Counters() :
+    fieldAdditions(0),
+    fieldSubtractions(0),
+    fieldMultiplications(0),
+    fieldDivisions(0),
+    fieldNegations(0),
+    fieldInversions(0),
+    fieldAllocations(0),
+    coefficientClones(0),
+    termConstructions(0),
+    termInsertions(0)
+{}
+
+polyjam::core::Counters
+polyjam::core::Counters::operator-( const Counters & earlier ) const
+{
+  Counters result;
+  result.fieldAdditions = fieldAdditions - earlier.fieldAdditions;
+  result.fieldSubtractions = fieldSubtractions - earlier.fieldSubtractions;
+  result.fieldMultiplications = fieldMultiplications - earlier.fieldMultiplications;
+  result.fieldDivisions = fieldDivisions - earlier.fieldDivisions;
+  result.fieldNegations = fieldNegations - earlier.fieldNegations;
+  result.fieldInversions = fieldInversions - earlier.fieldInversions;
+  result.fieldAllocations = fieldAllocations - earlier.fieldAllocations;
+  result.coefficientClones = coefficientClones - earlier.coefficientClones;
+  result.termConstructions = termConstructions - earlier.termConstructions;
+  result.termInsertions = termInsertions - earlier.termInsertions;
+  return result;
+}
+
+std::string
+polyjam::core::Counters::getString() const
+{
+  std::stringstream output;
+  output << "additions " << fieldAdditions;
+  output << ", subtractions " << fieldSubtractions;
+  output << ", multiplications " << fieldMultiplications;
+  output << ", divisions " << fieldDivisions;
+  output << ", negations " << fieldNegations;
+  output << ", inversions " << fieldInversions;
+  output << ", field allocations " << fieldAllocations;
+  output << ", coefficient clones " << coefficientClones;
+  output << ", term constructions " << termConstructions;
+  output << ", term insertions " << termInsertions;
+  return output.str();
+}
+
+bool
+polyjam::core::Counters::enabled()
+{
+#ifdef POLYJAM_COUNTERS
+  return true;
+#else
+  return false;
+#endif
+}
+
+polyjam::core::Counters &
+polyjam::core::Counters::local()
+{
+  thread_local Counters counters;
+  return counters;
+}
+
+polyjam::core::Counters
+polyjam::core::Counters::snapshot()
+{
+  return local();
+}
+
+polyjam::core::CounterScope::CounterScope() :
+    _start(Counters::snapshot())
+{}
+
+polyjam::core::Counters
+polyjam::core::CounterScope::elapsed() const
+{
+  return Counters::snapshot() - _start;
+}
+
+void
+polyjam::core::CounterScope::reset()
+{
+  _start = Counters::snapshot();
+}
@@ -0,0 +1,149 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#include <polyjam/core/GenerationContext.hpp>
+#include <sys/time.h>
+
+namespace
+{
+
+//the context of the innermost scope of each thread
+thread_local polyjam::core::GenerationContext * currentContext = NULL;
+
+}
+
+polyjam::core::GenerationContext::Options::Options() :
+    saveBeforePreElimination(false),
+    saveAfterPreElimination(false),
+    saveBeforeElimination(false),
+    saveAfterElimination(false),
+    savePolynomials(false),
+    saveMonomials(false),
+    useGaussJordan(false),
+    realEigenvaluesOnly(false),
+    exploitTrivialRows(false),
+    searchActionVariable(false),
+    maxSearchDegree(10),
+    checkpointInterval(600),
+    profile(false),
+    saveBenchmark(true)
+{}
+
+polyjam::core::GenerationContext::Scope::Scope( GenerationContext & context ) :
+    _previous(currentContext)
+{
+  currentContext = &context;
+}
+
+polyjam::core::GenerationContext::Scope::~Scope()
+{
+  currentContext = _previous;
+}
+
+polyjam::core::GenerationContext::GenerationContext() :
+    _workspacePath(WORKSPACEPATH),
+    _solverPath(SOLVERPATH),
+    _characteristic(DEFAULT_CHARACTERISTIC)
+{
+  struct timeval tic;
+  gettimeofday( &tic, 0 );
+  seed( tic.tv_usec );
+}
+
+polyjam::core::GenerationContext::GenerationContext(
+    unsigned int seed,
+    const std::string & workspacePath,
+    const std::string & solverPath,
+    unsigned int characteristic ) :
+    _generator(seed),
+    _workspacePath(workspacePath),
+    _solverPath(solverPath),
+    _characteristic(characteristic)
+{}
+
+void
+polyjam::core::GenerationContext::seed( unsigned int seed )
+{
+  _generator.seed(seed);
+}
+
+std::mt19937 &
+polyjam::core::GenerationContext::generator()
+{
+  return _generator;
+}
+
+const std::string &
+polyjam::core::GenerationContext::workspacePath() const
+{
+  return _workspacePath;
+}
+
+const std::string &
+polyjam::core::GenerationContext::solverPath() const
+{
+  return _solverPath;
+}
+
+unsigned int
+polyjam::core::GenerationContext::characteristic() const
+{
+  return _characteristic;
+}
+
+void
+polyjam::core::GenerationContext::setWorkspacePath( const std::string & workspacePath )
+{
+  _workspacePath = workspacePath;
+}
+
+void
+polyjam::core::GenerationContext::setSolverPath( const std::string & solverPath )
+{
+  _solverPath = solverPath;
+}
+
+void
+polyjam::core::GenerationContext::setCharacteristic( unsigned int characteristic )
+{
+  _characteristic = characteristic;
+}
+
+polyjam::core::GenerationContext::Options &
+polyjam::core::GenerationContext::options()
+{
+  return _options;
+}
+
+const polyjam::core::GenerationContext::Options &
+polyjam::core::GenerationContext::options() const
+{
+  return _options;
+}
+
+polyjam::core::GenerationContext &
+polyjam::core::GenerationContext::current()
+{
+  //every thread has its own default context
+  thread_local GenerationContext defaultContext;
+  if( currentContext == NULL )
+    return defaultContext;
+  return *currentContext;
+}
@@ -19,6 +19,7 @@
  *************************************************************************/
 
 #include <polyjam/core/Monomial.hpp>
+#include <polyjam/core/MonomialOrder.hpp>
 #include <sstream>
 #include <iostream>
 #include <math.h>
@@ -398,18 +399,7 @@ polyjam::core::Monomial::lexComparison( const Monomial & operant ) const
   if( isIncompatible(operant) )
     return 0;
   
-  for( size_t i = 0; i < _exponents.size(); i++ )
-  {
-    if( _exponents[i] !=  operant._exponents[i] )
-    {
-      if( _exponents[i] > operant._exponents[i] )
-        return 1;
-      else
-        return -1;
-    }
-  }
-  
-  return 0;
+  return OrderedComparison<LEX>::compare(*this,operant);
 }
 
 bool
@@ -439,32 +429,7 @@ polyjam::core::Monomial::revlexComparison( const Monomial & operant ) const
   // We reuse this in GrevLex, by taking RevLex only if the grades are same.
   // This does however not correspond with GrevLex in Macaulay!
   // In order to correspond, we have to start from the back!
-  
-  /*for( size_t i = 0; i < _exponents.size(); i++ )
-  {    
-    if( _exponents[i] != operant._exponents[i] )
-    {
-      if( _exponents[i] < operant._exponents[i] )
-        return 1;
-      else
-        return -1;
-    }
-  }*/
-  
-  int i = _exponents.size();
-  do
-  {
-    i--;
-    if( _exponents[i] != operant._exponents[i] )
-    {
-      if( _exponents[i] < operant._exponents[i] )
-        return 1;
-      else
-        return -1;
-    }
-  } while( i != 0);
-  
-  return 0;
+  return OrderedComparison<REVLEX>::compare(*this,operant);
 }
 
 bool
@@ -489,21 +454,8 @@ polyjam::core::Monomial::grlexComparison(
 {
   if( isIncompatible(operant) )
     return 0;
-
-  unsigned int thisDegree = degree();
-  unsigned int thatDegree = operant.degree();
-
-  if( thisDegree == thatDegree )
-    return lexComparison(operant);
-  else
-  {
-    if( thisDegree > thatDegree )
-      return 1;
-    else
-      return -1;
-  }
-
-  return 0;
+  
+  return OrderedComparison<GRLEX>::compare(*this,operant);
 }
 
 bool
@@ -528,21 +480,8 @@ polyjam::core::Monomial::grevlexComparison(
 {
   if( isIncompatible(operant) )
     return 0;
-
-  unsigned int thisDegree = degree();
-  unsigned int thatDegree = operant.degree();
-
-  if( thisDegree == thatDegree )
-    return revlexComparison(operant);
-  else
-  {
-    if( thisDegree > thatDegree )
-      return 1;
-    else
-      return -1;
-  }
-
-  return 0;
+  
+  return OrderedComparison<GREVLEX>::compare(*this,operant);
 }
 
 bool
@@ -0,0 +1,94 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#include <polyjam/core/MonomialTable.hpp>
+#include <polyjam/core/MonomialOrder.hpp>
+#include <algorithm>
+
+polyjam::core::MonomialTable::MonomialTable( Monomial::Order order ) :
+    _order(order)
+{}
+
+size_t
+polyjam::core::MonomialTable::insert( const Monomial & monomial )
+{
+  std::unordered_map<Monomial,size_t,MonomialHash>::iterator it = _ids.find(monomial);
+  if( it != _ids.end() )
+    return it->second;
+  
+  size_t id = _monomials.size();
+  _monomials.push_back(monomial);
+  _ids.insert( std::make_pair(monomial,id) );
+  return id;
+}
+
+int
+polyjam::core::MonomialTable::find( const Monomial & monomial ) const
+{
+  std::unordered_map<Monomial,size_t,MonomialHash>::const_iterator it = _ids.find(monomial);
+  if( it == _ids.end() )
+    return -1;
+  return it->second;
+}
+
+const polyjam::core::Monomial &
+polyjam::core::MonomialTable::monomial( size_t id ) const
+{
+  return _monomials[id];
+}
+
+size_t
+polyjam::core::MonomialTable::size() const
+{
+  return _monomials.size();
+}
+
+size_t
+polyjam::core::MonomialTable::multiply( size_t id1, size_t id2 )
+{
+  uint64_t key = (((uint64_t) id1) << 32) | ((uint64_t) id2);
+  std::unordered_map<uint64_t,size_t>::iterator it = _products.find(key);
+  if( it != _products.end() )
+    return it->second;
+  
+  size_t id = insert( _monomials[id1] * _monomials[id2] );
+  _products.insert( std::make_pair(key,id) );
+  return id;
+}
+
+size_t
+polyjam::core::MonomialTable::rank( size_t id )
+{
+  //sort all monomials again if some have been added in the meantime
+  if( _ranks.size() != _monomials.size() )
+  {
+    std::vector<size_t> sorted(_monomials.size());
+    for( size_t i = 0; i < sorted.size(); i++ )
+      sorted[i] = i;
+    MonomialGreater comp(_order);
+    std::sort( sorted.begin(), sorted.end(),
+        [&]( size_t i1, size_t i2 ) { return comp(_monomials[i1],_monomials[i2]); } );
+    
+    _ranks.resize(_monomials.size());
+    for( size_t i = 0; i < sorted.size(); i++ )
+      _ranks[sorted[i]] = i;
+  }
+  return _ranks[id];
+}
@@ -19,17 +19,42 @@
  *************************************************************************/
 
 #include <polyjam/core/Poly.hpp>
+#include <polyjam/core/PolyCache.hpp>
 #include <iostream>
 #include <sstream>
+#include <utility>
 
 using namespace std;
 
+namespace
+{
+
+//all term insertions go through here such that they can be counted
+inline void
+insertTerm( polyjam::core::Poly::terms_t & terms, const polyjam::core::Term & term )
+{
+  POLYJAM_COUNT(termInsertions);
+  terms.insert(term);
+}
+
+inline void
+insertTerm(
+    polyjam::core::Poly::terms_t & terms,
+    polyjam::core::Poly::terms_t::iterator hint,
+    const polyjam::core::Term & term )
+{
+  POLYJAM_COUNT(termInsertions);
+  terms.insert(hint,term);
+}
+
+}
+
 //constructors, destructor
 
 polyjam::core::Poly::Poly( const Term & term ) : _sugar(0)
 {
   _terms = termsPtr(new terms_t());
-  _terms->insert(term);
+  insertTerm(*_terms,term);
 }
 
 polyjam::core::Poly::~Poly()
@@ -40,7 +65,7 @@ polyjam::core::Poly::~Poly()
 polyjam::core::Poly &
 polyjam::core::Poly::operator=( const Poly & rhs )
 {
-  if( !leadingTerm().isSimilar(rhs.leadingTerm()) )
+  if( _terms && !leadingTerm().isSimilar(rhs.leadingTerm()) )
   {
     cout << "Error: cannot assign polynomial that has different character";
     cout << endl;
@@ -52,6 +77,21 @@ polyjam::core::Poly::operator=( const Poly & rhs )
   return (*this);
 }
 
+polyjam::core::Poly &
+polyjam::core::Poly::operator=( Poly && rhs )
+{
+  if( _terms && !leadingTerm().isSimilar(rhs.leadingTerm()) )
+  {
+    cout << "Error: cannot assign polynomial that has different character";
+    cout << endl;
+    return (*this);
+  }
+  
+  _terms = std::move(rhs._terms);
+  _sugar = rhs._sugar;
+  return (*this);
+}
+
 //output
 
 polyjam::core::Poly
@@ -65,7 +105,7 @@ polyjam::core::Poly::clone( bool full ) const
     ++iter;
     while( iter != _terms->end() )
     {
-      result._terms->insert(result._terms->end(), iter->clone(full));
+      insertTerm(*result._terms,result._terms->end(), iter->clone(full));
       ++iter;
     }
   }
@@ -82,12 +122,12 @@ polyjam::core::Poly::copy( const Poly & copy )
     cout << endl;
   }
   
-  _terms->clear();
+  clearTerms();
   for(
       terms_t::iterator iter = copy._terms->begin();
       iter != copy._terms->end();
       ++iter )
-    _terms->insert(_terms->end(), iter->clone() );
+    insertTerm(*_terms,_terms->end(), iter->clone() );
   
   _sugar = copy._sugar;
 }
@@ -107,6 +147,7 @@ polyjam::core::Poly::zero() const
 void
 polyjam::core::Poly::setDominant( int index )
 {
+  detach();
   for(
       terms_t::iterator iter = _terms->begin();
       iter != _terms->end();
@@ -150,7 +191,7 @@ polyjam::core::Poly::leadingTerm() const
 polyjam::core::Term
 polyjam::core::Poly::leadingCoefficient() const
 {
-  return Term( leadingTerm().coefficient().clone(), leadingTerm().monomial().one() );
+  return Term( leadingTerm().coefficient(), leadingTerm().monomial().one() );
 }
 
 
@@ -160,6 +201,12 @@ polyjam::core::Poly::leadingMonomial() const
   return Term( leadingTerm().coefficient().one(), leadingTerm().monomial() );
 }
 
+const polyjam::core::Ring &
+polyjam::core::Poly::ring() const
+{
+  return leadingTerm().ring();
+}
+
 polyjam::core::Poly::terms_t::iterator
 polyjam::core::Poly::begin() const
 {
@@ -214,7 +261,7 @@ polyjam::core::Poly::eval( const std::vector<Coefficient> & values ) const
       ++termIter )
   {
     const std::vector<unsigned int> & exponents = termIter->monomial().exponents();
-    Coefficient coeff = termIter->coefficient().clone();
+    Coefficient coeff = termIter->coefficient();
     
     for( size_t i = 0; i < exponents.size(); i++ )
     {
@@ -235,7 +282,7 @@ polyjam::core::Poly::eval( const std::vector<Coefficient> & values ) const
 polyjam::core::Poly
 polyjam::core::Poly::differentOrderVersion( Monomial::Order newOrder ) const
 {  
-  Term firstTerm(leadingTerm().clone());
+  Term firstTerm(leadingTerm());
   firstTerm.setOrder( newOrder );
   Poly newPoly(firstTerm);
   
@@ -246,9 +293,9 @@ polyjam::core::Poly::differentOrderVersion( Monomial::Order newOrder ) const
     
     while( iter != _terms->end() )
     {
-      Term nextTerm(iter->clone());
+      Term nextTerm(*iter);
       nextTerm.setOrder(newOrder);
-      newPoly._terms->insert(nextTerm);
+      insertTerm(*newPoly._terms,nextTerm);
       ++iter;
     }
   }
@@ -267,7 +314,7 @@ polyjam::core::Poly::lowerDegreeApproximation( unsigned int maxDegree ) const
       ++iter )
   {
     if( iter->monomial().degree() <= maxDegree )
-      result._terms->insert(result._terms->end(),iter->clone());
+      insertTerm(*result._terms,result._terms->end(),*iter);
   }
   
   //check that the size is bigger than one, because then we have to
@@ -290,7 +337,7 @@ polyjam::core::Poly::negation() const
     
     while( iter != _terms->end() )
     {
-      result._terms->insert(result._terms->end(),iter->negation());
+      insertTerm(*result._terms,result._terms->end(),iter->negation());
       ++iter;
     }
   }
@@ -301,7 +348,7 @@ polyjam::core::Poly::negation() const
 polyjam::core::Poly
 polyjam::core::Poly::operator+( const Poly & operant ) const
 {
-  Poly result(this->clone());
+  Poly result(*this);
   result += operant;
   return result;
 }
@@ -309,7 +356,7 @@ polyjam::core::Poly::operator+( const Poly & operant ) const
 polyjam::core::Poly
 polyjam::core::Poly::operator+( const Term & operant ) const
 {
-  Poly result(this->clone());
+  Poly result(*this);
   result += operant;
   return result;
 }
@@ -317,7 +364,7 @@ polyjam::core::Poly::operator+( const Term & operant ) const
 polyjam::core::Poly
 polyjam::core::Poly::operator-( const Poly & operant ) const
 {
-  Poly result(this->clone());
+  Poly result(*this);
   result -= operant;
   return result;
 }
@@ -325,16 +372,26 @@ polyjam::core::Poly::operator-( const Poly & operant ) const
 polyjam::core::Poly
 polyjam::core::Poly::operator-( const Term & operant ) const
 {
-  Poly result(this->clone());
+  Poly result(*this);
   result -= operant;
   return result;
 }
 
 polyjam::core::Poly
 polyjam::core::Poly::operator*( const Poly & operant ) const
+{
+  //repeated products are looked up if there is a product cache
+  PolyCache * cache = PolyCache::current();
+  if( cache != NULL )
+    return cache->multiply(*this,operant);
+  return product(operant);
+}
+
+polyjam::core::Poly
+polyjam::core::Poly::product( const Poly & operant ) const
 {
   //Actually the following would be inefficient
-  //Poly result(this->clone());
+  //Poly result(*this);
   //result *= operant;
   //return result;
   
@@ -345,7 +402,7 @@ polyjam::core::Poly::operator*( const Poly & operant ) const
       iter != operant._terms->end();
       ++iter )
   {
-    Poly temp(this->clone());
+    Poly temp(*this);
     temp *= (*iter);
     result += temp;
   }
@@ -356,7 +413,7 @@ polyjam::core::Poly::operator*( const Poly & operant ) const
 polyjam::core::Poly
 polyjam::core::Poly::operator*( const Term & operant ) const
 {
-  Poly result(this->clone());
+  Poly result(*this);
   result *= operant;
   return result;
 }
@@ -369,9 +426,9 @@ polyjam::core::Poly::differentOrderVersionInPlace( Monomial::Order newOrder )
 {
   termsPtr newTerms = termsPtr(new terms_t);
   
-  Term firstTerm(leadingTerm().clone());
+  Term firstTerm(leadingTerm());
   firstTerm.setOrder( newOrder );
-  newTerms->insert(firstTerm);
+  insertTerm(*newTerms,firstTerm);
   
   if( _terms->size() > 1 )
   {
@@ -380,9 +437,9 @@ polyjam::core::Poly::differentOrderVersionInPlace( Monomial::Order newOrder )
     
     while( iter != _terms->end() )
     {
-      Term nextTerm(iter->clone());
+      Term nextTerm(*iter);
       nextTerm.setOrder(newOrder);
-      newTerms->insert(nextTerm);
+      insertTerm(*newTerms,nextTerm);
       ++iter;
     }
   }
@@ -405,11 +462,11 @@ polyjam::core::Poly::lowerDegreeApproximationInPlace( unsigned int maxDegree )
       ++iter )
   {
     if( iter->monomial().degree() <= maxDegree )
-      newTerms->insert(newTerms->end(),*iter);
+      insertTerm(*newTerms,newTerms->end(),*iter);
   }
     
   if( newTerms->size() == 0 )
-    newTerms->insert(zeroTerm);
+    insertTerm(*newTerms,zeroTerm);
   
   swap(newTerms,_terms);
   return (*this);
@@ -418,6 +475,7 @@ polyjam::core::Poly::lowerDegreeApproximationInPlace( unsigned int maxDegree )
 polyjam::core::Poly &
 polyjam::core::Poly::negationInPlace()
 {
+  detach();
   for(
       terms_t::iterator iter = _terms->begin();
       iter != _terms->end();
@@ -461,15 +519,16 @@ polyjam::core::Poly::operator+=( const Term & operant )
   //check if this one is zero
   if( isZero() )
   {
-    _terms->clear();
-    _terms->insert(operant.clone());
+    clearTerms();
+    insertTerm(*_terms,operant);
     return (*this);
   }
   
   //now insert
+  detach();
   terms_t::iterator insertionPoint = _terms->lower_bound(operant);
   if( insertionPoint == _terms->end() || insertionPoint->monomial() != operant.monomial() )
-    _terms->insert(insertionPoint,operant.clone());
+    insertTerm(*_terms,insertionPoint,operant);
   else
   {
     //the item existed already
@@ -517,15 +576,16 @@ polyjam::core::Poly::operator-=( const Term & operant )
   //check if this one is zero
   if( isZero() )
   {
-    _terms->clear();
-    _terms->insert(operant.negation());
+    clearTerms();
+    insertTerm(*_terms,operant.negation());
     return (*this);
   }
   
   //now insert
+  detach();
   terms_t::iterator insertionPoint = _terms->lower_bound(operant);
   if( insertionPoint == _terms->end() || insertionPoint->monomial() != operant.monomial() )
-    _terms->insert(insertionPoint,operant.negation());
+    insertTerm(*_terms,insertionPoint,operant.negation());
   else
   {
     //the item existed already
@@ -547,6 +607,13 @@ polyjam::core::Poly::operator-=( const Term & operant )
 polyjam::core::Poly &
 polyjam::core::Poly::operator*=( const Poly & operant )
 {
+  PolyCache * cache = PolyCache::current();
+  if( cache != NULL )
+  {
+    (*this) = cache->multiply(*this,operant);
+    return (*this);
+  }
+  
   Poly result(this->zero());
   
   for(
@@ -554,7 +621,7 @@ polyjam::core::Poly::operator*=( const Poly & operant )
       iter != operant._terms->end();
       ++iter )
   {
-    Poly temp(this->clone());
+    Poly temp(*this);
     temp *= (*iter);
     result += temp;
   }
@@ -582,6 +649,7 @@ polyjam::core::Poly::operator*=( const Term & operant )
   }
   
   //now multiply each term
+  detach();
   for(
       terms_t::iterator iter = _terms->begin();
       iter != _terms->end();
@@ -666,8 +734,8 @@ polyjam::core::Poly &
 polyjam::core::Poly::setToOne()
 {
   Term oneTerm(leadingTerm().one());
-  _terms->clear();
-  _terms->insert(oneTerm);
+  clearTerms();
+  insertTerm(*_terms,oneTerm);
   return (*this);
 }
 
@@ -675,8 +743,8 @@ polyjam::core::Poly &
 polyjam::core::Poly::setToZero()
 {
   Term zeroTerm(leadingTerm().zero());
-  _terms->clear();
-  _terms->insert(zeroTerm);
+  clearTerms();
+  insertTerm(*_terms,zeroTerm);
   return (*this);
 }
 
@@ -693,3 +761,21 @@ polyjam::core::Poly::isOne() const
 {
   return _terms->size() == 1 && leadingTerm().isOne();
 }
+
+// copy-on-write
+
+void
+polyjam::core::Poly::detach()
+{
+  if( _terms.use_count() > 1 )
+    _terms = termsPtr(new terms_t(*_terms));
+}
+
+void
+polyjam::core::Poly::clearTerms()
+{
+  if( _terms.use_count() > 1 )
+    _terms = termsPtr(new terms_t());
+  else
+    _terms->clear();
+}
@@ -0,0 +1,153 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#include <polyjam/core/PolyCache.hpp>
+
+namespace
+{
+
+//the cache of the innermost scope of each thread
+thread_local polyjam::core::PolyCache * currentCache = NULL;
+
+}
+
+polyjam::core::PolyCache::Scope::Scope( PolyCache & cache ) :
+    _previous(currentCache)
+{
+  currentCache = &cache;
+}
+
+polyjam::core::PolyCache::Scope::~Scope()
+{
+  currentCache = _previous;
+}
+
+polyjam::core::PolyCache::PolyCache() : _hits(0)
+{}
+
+polyjam::core::PolyCache::~PolyCache()
+{}
+
+polyjam::core::Poly
+polyjam::core::PolyCache::intern( const Poly & poly )
+{
+  Poly result(poly);
+  
+  //terms that have been seen before are found by their address
+  std::unordered_map<key_t,std::pair<Poly,Poly> >::iterator seen =
+      _shared.find(poly._terms.get());
+  if( seen != _shared.end() )
+  {
+    result._terms = seen->second.second._terms;
+    return result;
+  }
+  
+  //otherwise look for an identical polynomial
+  size_t polyHash = hash(poly);
+  typedef std::unordered_multimap<size_t,Poly>::iterator iterator_t;
+  std::pair<iterator_t,iterator_t> range = _polys.equal_range(polyHash);
+  iterator_t shared = range.first;
+  while( shared != range.second && !isIdentical(shared->second,poly) )
+    ++shared;
+  if( shared == range.second )
+    shared = _polys.insert( std::make_pair(polyHash,poly) );
+  
+  _shared.insert( std::make_pair( poly._terms.get(), std::make_pair(poly,shared->second) ) );
+  result._terms = shared->second._terms;
+  return result;
+}
+
+polyjam::core::Poly
+polyjam::core::PolyCache::multiply( const Poly & p1, const Poly & p2 )
+{
+  Poly shared1 = intern(p1);
+  Poly shared2 = intern(p2);
+  std::pair<key_t,key_t> key( shared1._terms.get(), shared2._terms.get() );
+  
+  std::unordered_map<std::pair<key_t,key_t>,Poly,PairHash>::iterator product =
+      _products.find(key);
+  if( product != _products.end() )
+  {
+    _hits++;
+    return product->second;
+  }
+  
+  Poly result = intern( shared1.product(shared2) );
+  _products.insert( std::make_pair(key,result) );
+  return result;
+}
+
+size_t
+polyjam::core::PolyCache::size() const
+{
+  return _polys.size();
+}
+
+size_t
+polyjam::core::PolyCache::hits() const
+{
+  return _hits;
+}
+
+void
+polyjam::core::PolyCache::clear()
+{
+  _products.clear();
+  _shared.clear();
+  _polys.clear();
+  _hits = 0;
+}
+
+polyjam::core::PolyCache *
+polyjam::core::PolyCache::current()
+{
+  return currentCache;
+}
+
+size_t
+polyjam::core::PolyCache::hash( const Poly & poly ) const
+{
+  size_t hash = poly.size();
+  Poly::terms_t::iterator iter = poly.begin();
+  while( iter != poly.end() )
+  {
+    hash = hash * 31 + iter->hash();
+    ++iter;
+  }
+  return hash;
+}
+
+bool
+polyjam::core::PolyCache::isIdentical( const Poly & p1, const Poly & p2 ) const
+{
+  if( p1.size() != p2.size() )
+    return false;
+  
+  Poly::terms_t::iterator iter1 = p1.begin();
+  Poly::terms_t::iterator iter2 = p2.begin();
+  while( iter1 != p1.end() )
+  {
+    if( !iter1->isIdentical(*iter2) )
+      return false;
+    ++iter1;
+    ++iter2;
+  }
+  return true;
+}
@@ -51,7 +51,7 @@ polyjam::core::PolyMatrix::PolyMatrix(
       if( diag && (row != col) )
         newRow.push_back(PolyPtr( new Poly(base.zero()) ));
       else
-        newRow.push_back(PolyPtr( new Poly(base.clone()) ));
+        newRow.push_back(PolyPtr( new Poly(base) ));
     }
     
     _matrix.push_back(newRow);
@@ -87,7 +87,7 @@ polyjam::core::PolyMatrix::PolyMatrix(
       if( diag && (row != col) )
         newRow.push_back(PolyPtr( new Poly(base.zero()) ));
       else
-        newRow.push_back(PolyPtr( new Poly(base.clone()) ));
+        newRow.push_back(PolyPtr( new Poly(base) ));
     }
     
     _matrix.push_back(newRow);
@@ -97,9 +97,37 @@ polyjam::core::PolyMatrix::PolyMatrix(
   _maxDegree = maxDegree;
 }
 
+polyjam::core::PolyMatrix::PolyMatrix( const PolyMatrix & matrix ) :
+    _degreeLimitation(matrix._degreeLimitation),
+    _maxDegree(matrix._maxDegree)
+{
+  _matrix.reserve(matrix.rows());
+  
+  for( size_t row = 0; row < matrix.rows(); row++ )
+  {
+    std::vector<PolyPtr> newRow;
+    newRow.reserve(matrix.cols());
+    
+    for( size_t col = 0; col < matrix.cols(); col++ )
+      newRow.push_back(PolyPtr( new Poly( *(matrix._matrix[row][col]) ) ));
+    
+    _matrix.push_back(newRow);
+  }
+}
+
 polyjam::core::PolyMatrix::~PolyMatrix()
 {}
 
+//assignment
+
+polyjam::core::PolyMatrix &
+polyjam::core::PolyMatrix::operator=( const PolyMatrix & matrix )
+{
+  if( this != &matrix )
+    *this = PolyMatrix(matrix);
+  return (*this);
+}
+
 // deep stuff
 
 void
@@ -254,7 +282,7 @@ polyjam::core::PolyMatrix::transpose() const
     newRow.reserve(_cols);
     
     for( size_t col = 0; col < _cols; col++ )
-      newRow.push_back(PolyPtr(new Poly( _matrix[col][row]->clone() )));
+      newRow.push_back(PolyPtr(new Poly( *(_matrix[col][row]) )));
     
     result._matrix.push_back(newRow);
   }
@@ -269,7 +297,7 @@ polyjam::core::PolyMatrix::transpose() const
 polyjam::core::PolyMatrix
 polyjam::core::PolyMatrix::operator+( const PolyMatrix & operant ) const
 {  
-  PolyMatrix result = clone();
+  PolyMatrix result(*this);
   result += operant;
   return result;
 }
@@ -277,7 +305,7 @@ polyjam::core::PolyMatrix::operator+( const PolyMatrix & operant ) const
 polyjam::core::PolyMatrix
 polyjam::core::PolyMatrix::operator-( const PolyMatrix & operant ) const
 {
-  PolyMatrix result = clone();
+  PolyMatrix result(*this);
   result -= operant;
   return result;
 }
@@ -320,7 +348,7 @@ polyjam::core::PolyMatrix
 polyjam::core::PolyMatrix::operator*( const Poly & operant ) const
 {  
   //prepare the result matrix
-  PolyMatrix result = clone();
+  PolyMatrix result(*this);
   
   //do actual multiplication here
   for( size_t row = 0; row < rows(); row++ )
@@ -684,7 +712,7 @@ polyjam::core::PolyMatrix::determinant() const
     for( size_t r = 0; r < subRows.size(); r++ )
     {
       for( size_t c = 0; c < subCols.size(); c++ )
-        sub(r,c) = _matrix[subRows[r]][subCols[c]]->clone();
+        sub(r,c) = *(_matrix[subRows[r]][subCols[c]]);
     }
     
     Poly temp = sub.determinant();
@@ -731,7 +759,7 @@ polyjam::core::PolyMatrix::trace() const
     return _matrix[0][0]->zero();
   }
   
-  Poly result = _matrix[0][0]->clone();
+  Poly result = *(_matrix[0][0]);
   for( size_t i = 1; i < rows(); i++ )
     result += *(_matrix[i][i]);
   
@@ -0,0 +1,235 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#include <polyjam/core/Ring.hpp>
+#include <polyjam/core/Poly.hpp>
+#include <sstream>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+
+//all rings ever requested, they live until the end of the program
+std::list< std::unique_ptr<polyjam::core::Ring> > & registry()
+{
+  static std::list< std::unique_ptr<polyjam::core::Ring> > rings;
+  return rings;
+}
+
+std::mutex registryMutex;
+
+}
+
+polyjam::core::Ring::Ring(
+    size_t dimensions, Monomial::Order order, const kinds_t & kinds ) :
+    _dimensions(dimensions), _order(order), _kinds(kinds)
+{}
+
+const polyjam::core::Ring &
+polyjam::core::Ring::get(
+    size_t dimensions, Monomial::Order order, const kinds_t & kinds )
+{
+  std::lock_guard<std::mutex> lock(registryMutex);
+  
+  std::list< std::unique_ptr<Ring> > & rings = registry();
+  for(
+      std::list< std::unique_ptr<Ring> >::iterator iter = rings.begin();
+      iter != rings.end();
+      ++iter )
+  {
+    const Ring & ring = **iter;
+    if( ring._dimensions == dimensions && ring._order == order && ring._kinds == kinds )
+      return ring;
+  }
+  
+  rings.push_back( std::unique_ptr<Ring>( new Ring(dimensions,order,kinds) ) );
+  return *(rings.back());
+}
+
+const polyjam::core::Ring &
+polyjam::core::Ring::get(
+    const CoefficientList & coefficients, const Monomial & monomial )
+{
+  //terms are mostly created in the ring of the previous one, so remember the
+  //last ring of this thread and avoid the lock
+  thread_local const Ring * last = NULL;
+  if( last != NULL && last->matches(coefficients,monomial) )
+    return *last;
+  
+  kinds_t kinds;
+  kinds.reserve(coefficients.size());
+  for( size_t i = 0; i < coefficients.size(); i++ )
+    kinds.push_back(coefficients[i].kind());
+  
+  last = &get(monomial.dimensions(),monomial.order(),kinds);
+  return *last;
+}
+
+const polyjam::core::Ring &
+polyjam::core::Ring::R( size_t dimensions, Monomial::Order order )
+{
+  return get(dimensions,order,kinds_t(1,fields::Field::R));
+}
+
+const polyjam::core::Ring &
+polyjam::core::Ring::Q( size_t dimensions, Monomial::Order order )
+{
+  return get(dimensions,order,kinds_t(1,fields::Field::Q));
+}
+
+const polyjam::core::Ring &
+polyjam::core::Ring::Z( size_t dimensions, Monomial::Order order )
+{
+  return get(dimensions,order,kinds_t(1,fields::Field::Zp));
+}
+
+const polyjam::core::Ring &
+polyjam::core::Ring::S( size_t dimensions, Monomial::Order order )
+{
+  return get(dimensions,order,kinds_t(1,fields::Field::Sym));
+}
+
+const polyjam::core::Ring &
+polyjam::core::Ring::SZ( size_t dimensions, Monomial::Order order )
+{
+  //the Zp coefficient is stored first (see the constructors of Term)
+  kinds_t kinds;
+  kinds.push_back(fields::Field::Zp);
+  kinds.push_back(fields::Field::Sym);
+  return get(dimensions,order,kinds);
+}
+
+// properties
+
+size_t
+polyjam::core::Ring::dimensions() const
+{
+  return _dimensions;
+}
+
+polyjam::core::Monomial::Order
+polyjam::core::Ring::order() const
+{
+  return _order;
+}
+
+const polyjam::core::Ring::kinds_t &
+polyjam::core::Ring::kinds() const
+{
+  return _kinds;
+}
+
+bool
+polyjam::core::Ring::isMultiple() const
+{
+  return _kinds.size() > 1;
+}
+
+std::string
+polyjam::core::Ring::getString() const
+{
+  std::stringstream output;
+  for( size_t i = 0; i < _kinds.size(); i++ )
+  {
+    if( i > 0 )
+      output << ",";
+    switch( _kinds[i] )
+    {
+      case fields::Field::R:   output << "R";   break;
+      case fields::Field::Q:   output << "Q";   break;
+      case fields::Field::Zp:  output << "Zp";  break;
+      case fields::Field::Sym: output << "Sym"; break;
+    }
+  }
+  
+  output << "[x_1..x_" << _dimensions << "] ";
+  
+  switch( _order )
+  {
+    case Monomial::LEX:     output << "LEX";     break;
+    case Monomial::REVLEX:  output << "REVLEX";  break;
+    case Monomial::GRLEX:   output << "GRLEX";   break;
+    case Monomial::GREVLEX: output << "GREVLEX"; break;
+  }
+  
+  return output.str();
+}
+
+// polynomials of this ring
+
+polyjam::core::Monomial
+polyjam::core::Ring::monomial() const
+{
+  return Monomial(_dimensions,_order);
+}
+
+polyjam::core::Poly
+polyjam::core::Ring::zero() const
+{
+  std::vector<Coefficient> coefficients;
+  for( size_t i = 0; i < _kinds.size(); i++ )
+    coefficients.push_back(Coefficient(_kinds[i]));
+  return Poly(Term(coefficients,monomial()));
+}
+
+polyjam::core::Poly
+polyjam::core::Ring::one() const
+{
+  return constant(1);
+}
+
+polyjam::core::Poly
+polyjam::core::Ring::constant( int constant ) const
+{
+  std::vector<Coefficient> coefficients;
+  for( size_t i = 0; i < _kinds.size(); i++ )
+    coefficients.push_back(Coefficient(constant,_kinds[i]));
+  return Poly(Term(coefficients,monomial()));
+}
+
+polyjam::core::Poly
+polyjam::core::Ring::variable( size_t index ) const
+{
+  std::vector<Coefficient> coefficients;
+  for( size_t i = 0; i < _kinds.size(); i++ )
+    coefficients.push_back(Coefficient(1,_kinds[i]));
+  return Poly(Term(coefficients,Monomial(_dimensions,index,_order)));
+}
+
+// private
+
+bool
+polyjam::core::Ring::matches(
+    const CoefficientList & coefficients,
+    const Monomial & monomial ) const
+{
+  if( monomial.dimensions() != _dimensions || monomial.order() != _order )
+    return false;
+  if( coefficients.size() != _kinds.size() )
+    return false;
+  for( size_t i = 0; i < coefficients.size(); i++ )
+  {
+    if( coefficients[i].kind() != _kinds[i] )
+      return false;
+  }
+  return true;
+}
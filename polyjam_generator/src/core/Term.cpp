@@ -19,6 +19,7 @@
  *************************************************************************/
 
 #include <polyjam/core/Term.hpp>
+#include <polyjam/core/MonomialOrder.hpp>
 #include <iostream>
 #include <sstream>
 
@@ -30,7 +31,9 @@ polyjam::core::Term::Term(
     const Monomial & monomial ) :
      _dominantIndex(0), _monomial(monomial)
 {
+  POLYJAM_COUNT(termConstructions);
   _coefficients.push_back(coefficient);
+  _ring = &Ring::get(_coefficients,_monomial);
 }
 
 polyjam::core::Term::Term(
@@ -39,15 +42,30 @@ polyjam::core::Term::Term(
     const Monomial & monomial ) :
     _dominantIndex(0), _monomial(monomial)
 {
+  POLYJAM_COUNT(termConstructions);
   _coefficients.push_back(coeff2);
   _coefficients.push_back(coeff1);
+  _ring = &Ring::get(_coefficients,_monomial);
 }
 
 polyjam::core::Term::Term(
     const std::vector<Coefficient> & coefficients,
     const Monomial & monomial ) :
-    _coefficients(coefficients), _dominantIndex(0), _monomial(monomial)
-{}
+    _coefficients(coefficients), _dominantIndex(0), _monomial(monomial),
+    _ring(&Ring::get(coefficients,monomial))
+{
+  POLYJAM_COUNT(termConstructions);
+}
+
+polyjam::core::Term::Term(
+    CoefficientList && coefficients,
+    const Monomial & monomial,
+    const Ring * ring ) :
+    _coefficients(std::move(coefficients)), _dominantIndex(0), _monomial(monomial),
+    _ring(ring)
+{
+  POLYJAM_COUNT(termConstructions);
+}
 
 polyjam::core::Term::~Term()
 {}
@@ -57,10 +75,10 @@ polyjam::core::Term::clone( bool full ) const
 {
   if(full)
   {
-    std::vector<Coefficient> newCoefficients;
+    CoefficientList newCoefficients;
     for( size_t i = 0; i < _coefficients.size(); i++ )
       newCoefficients.push_back(_coefficients[i].clone());
-    return Term( newCoefficients, _monomial );
+    return Term( std::move(newCoefficients), _monomial, _ring );
   }
   return Term( _coefficients[_dominantIndex].clone(), _monomial );
 }
@@ -73,6 +91,7 @@ polyjam::core::Term::copy( const Term & copy )
     _coefficients.push_back(copy._coefficients[i].clone());
   _dominantIndex = copy._dominantIndex;
   _monomial = copy._monomial;
+  _ring = copy._ring;
 }
 
 polyjam::core::Term
@@ -80,10 +99,10 @@ polyjam::core::Term::zero( bool full ) const
 {
   if(full)
   {
-    std::vector<Coefficient> newCoefficients;
+    CoefficientList newCoefficients;
     for( size_t i = 0; i < _coefficients.size(); i++ )
       newCoefficients.push_back(_coefficients[i].zero());
-    return Term( newCoefficients, _monomial.one() );
+    return Term( std::move(newCoefficients), _monomial.one(), _ring );
   }
   return Term( _coefficients[_dominantIndex].zero(), _monomial.one() );
 }
@@ -93,10 +112,10 @@ polyjam::core::Term::one( bool full ) const
 {
   if(full)
   {
-    std::vector<Coefficient> newCoefficients;
+    CoefficientList newCoefficients;
     for( size_t i = 0; i < _coefficients.size(); i++ )
       newCoefficients.push_back(_coefficients[i].one());
-    return Term( newCoefficients, _monomial.one() );
+    return Term( std::move(newCoefficients), _monomial.one(), _ring );
   }
   return Term( _coefficients[_dominantIndex].one(), _monomial.one() );
 }
@@ -158,19 +177,26 @@ polyjam::core::Term::coefficient() const
   return _coefficients[_dominantIndex];
 }
 
+const polyjam::core::Ring &
+polyjam::core::Term::ring() const
+{
+  return *_ring;
+}
+
 void
 polyjam::core::Term::setOrder( Monomial::Order newOrder )
 {
   _monomial.setOrder(newOrder);
+  _ring = &Ring::get(_coefficients,_monomial);
 }
 
 polyjam::core::Term
 polyjam::core::Term::negation() const
 {
-  std::vector<Coefficient> newCoefficients;
+  CoefficientList newCoefficients;
   for( size_t i = 0; i < _coefficients.size(); i++ )
     newCoefficients.push_back(_coefficients[i].negation());
-  return Term( newCoefficients, _monomial );
+  return Term( std::move(newCoefficients), _monomial, _ring );
 }
 
 polyjam::core::Term
@@ -185,11 +211,11 @@ polyjam::core::Term::operator+( const Term & operant ) const
     return Term(*this);
   }
   
-  std::vector<Coefficient> newCoefficients;
+  CoefficientList newCoefficients;
   for( size_t i = 0; i < _coefficients.size(); i++ )
     newCoefficients.push_back( _coefficients[i] + operant._coefficients[i] );
   
-  return Term( newCoefficients, _monomial );
+  return Term( std::move(newCoefficients), _monomial, _ring );
 }
 
 polyjam::core::Term
@@ -204,11 +230,11 @@ polyjam::core::Term::operator-( const Term & operant ) const
     return Term(*this);
   }
   
-  std::vector<Coefficient> newCoefficients;
+  CoefficientList newCoefficients;
   for( size_t i = 0; i < _coefficients.size(); i++ )
     newCoefficients.push_back( _coefficients[i] - operant._coefficients[i] );
   
-  return Term( newCoefficients, _monomial );
+  return Term( std::move(newCoefficients), _monomial, _ring );
 }
 
 polyjam::core::Term
@@ -217,11 +243,11 @@ polyjam::core::Term::operator*( const Term & operant ) const
   if( isWrong(operant) )
     return Term(*this);
 
-  std::vector<Coefficient> newCoefficients;
+  CoefficientList newCoefficients;
   for( size_t i = 0; i < _coefficients.size(); i++ )
     newCoefficients.push_back( _coefficients[i] * operant._coefficients[i] );
   
-  return Term( newCoefficients, _monomial * operant._monomial );
+  return Term( std::move(newCoefficients), _monomial * operant._monomial, _ring );
 }
 
 polyjam::core::Term
@@ -230,11 +256,11 @@ polyjam::core::Term::operator/( const Term & operant ) const
   if( isWrong(operant) )
     return Term(*this);
 
-  std::vector<Coefficient> newCoefficients;
+  CoefficientList newCoefficients;
   for( size_t i = 0; i < _coefficients.size(); i++ )
     newCoefficients.push_back( _coefficients[i] / operant._coefficients[i] );
   
-  return Term( newCoefficients, _monomial / operant._monomial );
+  return Term( std::move(newCoefficients), _monomial / operant._monomial, _ring );
 }
 
 polyjam::core::Term &
@@ -313,7 +339,7 @@ polyjam::core::Term::operator==( const Term & operant ) const
 {
   //use of dominant coefficient only!
   
-  if( _monomial.order() != operant.monomial().order() )
+  if( _ring != operant._ring && _ring->order() != operant._ring->order() )
     cout << "WARNING: Mixing terms with different default-order" << endl;
   
   return (
@@ -326,7 +352,7 @@ polyjam::core::Term::operator!=( const Term & operant ) const
 {
   //use of dominant coefficient only!
   
-  if( _monomial.order() != operant.monomial().order() )
+  if( _ring != operant._ring && _ring->order() != operant._ring->order() )
     cout << "WARNING: Mixing terms with different default-order" << endl;
 
   return (
@@ -337,32 +363,57 @@ polyjam::core::Term::operator!=( const Term & operant ) const
 bool
 polyjam::core::Term::operator>( const Term & operant ) const
 {
-  if( _monomial.order() != operant.monomial().order() )
+  if( _ring != operant._ring && _ring->order() != operant._ring->order() )
     cout << "ERROR: Comparing terms with different default-order" << endl;
   
   return _monomial > operant._monomial;
 }
 
+bool
+polyjam::core::TermGreater::operator()( const Term & t1, const Term & t2 ) const
+{
+  if( &t1.ring() != &t2.ring() )
+    return t1 > t2;
+  
+  return MonomialGreater(t1.ring().order())(t1.monomial(),t2.monomial());
+}
+
 bool
 polyjam::core::Term::isSimilar( const Term & operant ) const
 {
-  if( _coefficients.size() != operant._coefficients.size() )
+  //rings are unique, so this compares the fields, dimensions and order
+  return _ring == operant._ring;
+}
+
+bool
+polyjam::core::Term::isIdentical( const Term & operant ) const
+{
+  if( _ring != operant._ring || _dominantIndex != operant._dominantIndex )
+    return false;
+  if( _monomial != operant._monomial )
     return false;
-  
   for( size_t i = 0; i < _coefficients.size(); i++ )
   {
-    if( _coefficients[i].kind() != operant._coefficients[i].kind() )
+    if( _coefficients[i] != operant._coefficients[i] )
       return false;
   }
-  
-  if( _monomial.dimensions() != operant._monomial.dimensions() )
-    return false;
-  if( _monomial.order() != operant._monomial.order() )
-    return false;
-    
   return true;
 }
 
+size_t
+polyjam::core::Term::hash() const
+{
+  //the symbolic coefficient of a dual representation is left out, the Zp one
+  //is a much cheaper fingerprint
+  size_t hash = MonomialHash()(_monomial) * 31 + _dominantIndex;
+  for( size_t i = 0; i < _coefficients.size(); i++ )
+  {
+    if( _coefficients.size() == 1 || _coefficients[i].kind() != fields::Field::Sym )
+      hash = hash * 31 + _coefficients[i].hash();
+  }
+  return hash;
+}
+
 polyjam::core::Term &
 polyjam::core::Term::setToOne()
 {
@@ -400,7 +451,10 @@ polyjam::core::Term::isZero() const
 bool
 polyjam::core::Term::isWrong( const Term & operant ) const
 {
-  if( _monomial.order() != operant._monomial.order() )
+  if( _ring == operant._ring )
+    return false;
+  
+  if( _ring->order() != operant._ring->order() )
     cout << "WARNING: Mixing terms with different default-order" << endl;
   if( _coefficients.size() != operant._coefficients.size() )
   {
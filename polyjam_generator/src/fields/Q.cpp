@@ -27,19 +27,14 @@
 using namespace std;
 
 
-polyjam::fields::Q::Q( bool random ) :
-    Field(Field::Q), _numerator(0), _denominator(1)
+polyjam::fields::Q::Q( std::mt19937 & generator ) :
+    Field(Field::Q)
 {
-  if(random)
-  {
-    _numerator =
-        floor(((double) rand())/ ((double) RAND_MAX) *
-        ((double) numeric_limits<int64_t>::max()) );
-    _denominator =
-        floor(((double) rand())/ ((double) RAND_MAX) *
-        ((double) numeric_limits<uint64_t>::max()) );
-    clean();
-  }
+  std::uniform_int_distribution<int64_t> numerator(0,numeric_limits<int64_t>::max());
+  std::uniform_int_distribution<uint64_t> denominator(1,numeric_limits<uint64_t>::max());
+  _numerator = numerator(generator);
+  _denominator = denominator(generator);
+  clean();
 }
 
 polyjam::fields::Q::Q( int64_t numerator, uint64_t denominator ) :
@@ -104,12 +99,14 @@ polyjam::fields::Q::one() const
 void
 polyjam::fields::Q::negation()
 {  
+  POLYJAM_COUNT(fieldNegations);
   _numerator *= -1;
 }
 
 void
 polyjam::fields::Q::inversion()
 {
+  POLYJAM_COUNT(fieldInversions);
   if(_denominator == 0)
   {
     cout << "Error: attempt to invert a degenerate Q member!" << endl;
@@ -138,6 +135,7 @@ polyjam::fields::Q::inversion()
 void
 polyjam::fields::Q::add( const Field* operant )
 {
+  POLYJAM_COUNT(fieldAdditions);
   if(isWrong(operant))
     return;
 
@@ -160,6 +158,7 @@ polyjam::fields::Q::add( const Field* operant )
 void
 polyjam::fields::Q::subtract( const Field* operant )
 {
+  POLYJAM_COUNT(fieldSubtractions);
   if(isWrong(operant))
     return;
 
@@ -182,6 +181,7 @@ polyjam::fields::Q::subtract( const Field* operant )
 void
 polyjam::fields::Q::multiply( const Field* operant )
 {
+  POLYJAM_COUNT(fieldMultiplications);
   if(isWrong(operant))
     return;
 
@@ -212,6 +212,7 @@ polyjam::fields::Q::multiply( const Field* operant )
 void
 polyjam::fields::Q::divide( const Field* operant )
 {
+  POLYJAM_COUNT(fieldDivisions);
   if(isWrong(operant))
     return;
   
@@ -26,13 +26,11 @@
 using namespace std;
 
 
-polyjam::fields::R::R( bool random ) :
-    Field(Field::R), _value(0.0)
+polyjam::fields::R::R( std::mt19937 & generator ) :
+    Field(Field::R)
 {
-  if(random)
-    _value = (((double) rand()) / ((double) RAND_MAX) - 0.5) * 2.0 * 1000.0;
-/*        (((double) rand())/ ((double) RAND_MAX)) *
-        numeric_limits<double>::max();*/
+  std::uniform_real_distribution<double> distribution(-1000.0,1000.0);
+  _value = distribution(generator);
 }
 
 polyjam::fields::R::R( double value) : Field(Field::R), _value(value)
@@ -81,12 +79,14 @@ polyjam::fields::R::one() const
 void
 polyjam::fields::R::negation()
 {  
+  POLYJAM_COUNT(fieldNegations);
   _value *= -1.0;
 }
 
 void
 polyjam::fields::R::inversion()
 {
+  POLYJAM_COUNT(fieldInversions);
   if( _value == 0.0 )
   {
     cout << "Error: attempt to invert zero!" << endl;
@@ -98,6 +98,7 @@ polyjam::fields::R::inversion()
 void
 polyjam::fields::R::add( const Field* operant )
 {
+  POLYJAM_COUNT(fieldAdditions);
   if(isWrong(operant))
     return;
 
@@ -108,6 +109,7 @@ polyjam::fields::R::add( const Field* operant )
 void
 polyjam::fields::R::subtract( const Field* operant )
 {
+  POLYJAM_COUNT(fieldSubtractions);
   if(isWrong(operant))
     return;
 
@@ -118,6 +120,7 @@ polyjam::fields::R::subtract( const Field* operant )
 void
 polyjam::fields::R::multiply( const Field* operant )
 {
+  POLYJAM_COUNT(fieldMultiplications);
   if(isWrong(operant))
     return;
 
@@ -128,6 +131,7 @@ polyjam::fields::R::multiply( const Field* operant )
 void
 polyjam::fields::R::divide( const Field* operant )
 {
+  POLYJAM_COUNT(fieldDivisions);
   if(isWrong(operant))
     return;
   
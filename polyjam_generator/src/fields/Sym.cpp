@@ -191,6 +191,7 @@ polyjam::fields::Sym::one() const
 void
 polyjam::fields::Sym::negation()
 {  
+  POLYJAM_COUNT(fieldNegations);
   for(
       symCombination_t::iterator iter = _combination->begin();
       iter != _combination->end();
@@ -201,6 +202,7 @@ polyjam::fields::Sym::negation()
 void
 polyjam::fields::Sym::inversion()
 {
+  POLYJAM_COUNT(fieldInversions);
   cout << "Error: inversion of symbolic coefficient is not yet supported!";
   cout << endl;
 }
@@ -208,6 +210,7 @@ polyjam::fields::Sym::inversion()
 void
 polyjam::fields::Sym::add( const Field* operant )
 {
+  POLYJAM_COUNT(fieldAdditions);
   if(isWrong(operant) )
     return;
 
@@ -239,6 +242,7 @@ polyjam::fields::Sym::add( const Field* operant )
 void
 polyjam::fields::Sym::subtract( const Field* operant )
 {
+  POLYJAM_COUNT(fieldSubtractions);
   if(isWrong(operant) )
     return;
 
@@ -272,6 +276,7 @@ polyjam::fields::Sym::subtract( const Field* operant )
 void
 polyjam::fields::Sym::multiply( const Field* operant )
 {
+  POLYJAM_COUNT(fieldMultiplications);
   if(isWrong(operant) )
     return;
 
@@ -317,6 +322,7 @@ polyjam::fields::Sym::multiply( const Field* operant )
 void
 polyjam::fields::Sym::divide( const Field* operant )
 {
+  POLYJAM_COUNT(fieldDivisions);
   cout << "Error: division of symbolic coefficients is not yet supported!";
   cout << endl;
 }
@@ -27,15 +27,12 @@ using namespace std;
 
 
 polyjam::fields::Zp::Zp(
-    bool random, unsigned int characteristic ) : Field(Field::Zp),
-    _value(0), _characteristic(characteristic)
+    std::mt19937 & generator, unsigned int characteristic ) : Field(Field::Zp),
+    _characteristic(characteristic)
 {
-  if( random )
-  {
-    double dval = ((double) rand())/ ((double) RAND_MAX) * (_characteristic-1);
-    _value = floor(dval+0.5);
-  }
-};
+  std::uniform_int_distribution<unsigned int> distribution(0,_characteristic-1);
+  _value = distribution(generator);
+}
 
 polyjam::fields::Zp::Zp(
     int value, unsigned int characteristic ) : Field(Field::Zp),
@@ -81,21 +78,28 @@ polyjam::fields::Zp::characteristic() const
   return _characteristic;
 }
 
+unsigned int
+polyjam::fields::Zp::value() const
+{
+  return _value;
+}
+
 polyjam::fields::Field*
 polyjam::fields::Zp::zero() const
 {
-  return (new Zp(0));
+  return (new Zp(0,_characteristic));
 }
 
 polyjam::fields::Field*
 polyjam::fields::Zp::one() const
 {
-  return (new Zp(1));
+  return (new Zp(1,_characteristic));
 }
 
 void
 polyjam::fields::Zp::negation()
 {  
+  POLYJAM_COUNT(fieldNegations);
   int temp = (int) _value;
   temp *= -1;
   _value = moduloPrime(temp);
@@ -104,12 +108,14 @@ polyjam::fields::Zp::negation()
 void
 polyjam::fields::Zp::inversion()
 {
+  POLYJAM_COUNT(fieldInversions);
   _value = getMultiplicativeInverse(_value);
 }
 
 void
 polyjam::fields::Zp::add( const Field* operant )
 {
+  POLYJAM_COUNT(fieldAdditions);
   if(isWrong(operant))
     return;
     
@@ -120,6 +126,7 @@ polyjam::fields::Zp::add( const Field* operant )
 void
 polyjam::fields::Zp::subtract( const Field* operant )
 {
+  POLYJAM_COUNT(fieldSubtractions);
   if(isWrong(operant))
     return;
     
@@ -130,6 +137,7 @@ polyjam::fields::Zp::subtract( const Field* operant )
 void
 polyjam::fields::Zp::multiply( const Field* operant )
 {
+  POLYJAM_COUNT(fieldMultiplications);
   if(isWrong(operant))
     return;
     
@@ -140,6 +148,7 @@ polyjam::fields::Zp::multiply( const Field* operant )
 void
 polyjam::fields::Zp::divide( const Field* operant )
 {
+  POLYJAM_COUNT(fieldDivisions);
   if(isWrong(operant))
     return;
   
@@ -23,103 +23,38 @@
 #include <set>
 #include <algorithm>
 #include <polyjam/math/GaussJordan.hpp>
+#include <polyjam/core/MonomialOrder.hpp>
 
 #include <sstream>
 
-namespace polyjam
-{
-namespace generator
-{
-
-class Comp
-{
-public:
-  bool operator()(
-      const polyjam::core::Monomial & m1,
-      const polyjam::core::Monomial & m2 )
-  {
-    return m1 > m2;
-  }
-};
-
-}
-}
-
 using namespace std;
 
 //constructors
-polyjam::generator::CMatrix::CMatrix( const polynomials_t & polynomials )
+polyjam::generator::CMatrix::CMatrix( const polynomials_t & polynomials ) :
+    _operations(0)
 {
   fillMonomials( polynomials );
   fillMatrix( polynomials );
 }
 
-polyjam::generator::CMatrix::CMatrix( const polynomials_t & polynomials, const eqs_t & equations )
+polyjam::generator::CMatrix::CMatrix( const polynomials_t & polynomials, const eqs_t & equations, core::MonomialTable * table ) :
+    _operations(0)
 {
-  //extract all polynomials
-  std::vector<polynomials_t::const_iterator> polynomialsIters;
-  polynomials_t::const_iterator it = polynomials.begin();
-  while( it != polynomials.end() )
-  {
-    polynomialsIters.push_back(it);
-    ++it;
-  }
-  
-  polynomials_t allPolynomials;
-  core::Coefficient one(polynomials.front()->leadingTerm().coefficient().one());
-  for( size_t i = 0; i < equations.size(); i++ )
-  {
-    core::Term expander( one.clone(), equations[i].second );
-    allPolynomials.push_back( new core::Poly( (**(polynomialsIters[equations[i].first]) ) * expander ) );
-  }
-  
-  fillMonomials( allPolynomials );
-  fillMatrix( allPolynomials );
-  
-  //delete all polynomials
-  it = allPolynomials.begin();
-  while( it != allPolynomials.end() )
-  {
-    delete (*it);
-    ++it;
-  }
+  fillExpanded( polynomials, equations, true, table );
 }
 
-polyjam::generator::CMatrix::CMatrix( const polynomials_t & polynomials, const monomials_t & order )
+polyjam::generator::CMatrix::CMatrix( const polynomials_t & polynomials, const monomials_t & order ) :
+    _operations(0)
 {
   _monomials = order;
   fillMatrix(polynomials,false);
 }
 
-polyjam::generator::CMatrix::CMatrix( const polynomials_t & polynomials, const monomials_t & order, const eqs_t & equations )
+polyjam::generator::CMatrix::CMatrix( const polynomials_t & polynomials, const monomials_t & order, const eqs_t & equations, core::MonomialTable * table ) :
+    _operations(0)
 {
-  //extract all polynomials
-  std::vector<polynomials_t::const_iterator> polynomialsIters;
-  polynomials_t::const_iterator it = polynomials.begin();
-  while( it != polynomials.end() )
-  {
-    polynomialsIters.push_back(it);
-    ++it;
-  }
-  
-  polynomials_t allPolynomials;
-  core::Coefficient one(polynomials.front()->leadingTerm().coefficient().one());
-  for( size_t i = 0; i < equations.size(); i++ )
-  {
-    core::Term expander( one.clone(), equations[i].second );
-    allPolynomials.push_back( new core::Poly( (**(polynomialsIters[equations[i].first]) ) * expander ) );
-  }
-
   _monomials = order;
-  fillMatrix(allPolynomials,false);
-  
-  //delete all polynomials
-  it = allPolynomials.begin();
-  while( it != allPolynomials.end() )
-  {
-    delete (*it);
-    ++it;
-  }
+  fillExpanded( polynomials, equations, false, table );
 }
 
 //destructor
@@ -133,7 +68,8 @@ polyjam::generator::CMatrix::~CMatrix()
 void
 polyjam::generator::CMatrix::reduce()
 {
-  math::gaussReduction(_matrix);
+  _operations = 0;
+  math::gaussReduction(_matrix,false,&_operations);
 }
 
 //accessors
@@ -149,10 +85,31 @@ polyjam::generator::CMatrix::cols()
   return _monomials.size();
 }
 
+size_t
+polyjam::generator::CMatrix::nonzeros()
+{
+  size_t count = 0;
+  for( size_t row = 0; row < _matrix.size(); row++ )
+  {
+    for( size_t col = 0; col < _matrix[row]->size(); col++ )
+    {
+      if( !(*(_matrix[row]))[col].isZero() )
+        count++;
+    }
+  }
+  return count;
+}
+
+size_t
+polyjam::generator::CMatrix::operations()
+{
+  return _operations;
+}
+
 polyjam::core::Coefficient
 polyjam::generator::CMatrix::operator()( size_t row, size_t col )
 {
-  return (*(_matrix[row]))[col].clone();
+  return (*(_matrix[row]))[col];
 }
 
 polyjam::generator::CMatrix
@@ -166,7 +123,7 @@ polyjam::generator::CMatrix::subMatrix( const std::list<int> & rows )
     crow_t* newRow = new crow_t();
     newRow->reserve(_matrix[*i]->size());
     for( size_t x = 0; x < _matrix[*i]->size(); x++ )
-      newRow->push_back((*(_matrix[*i]))[x].clone());
+      newRow->push_back((*(_matrix[*i]))[x]);
     subMatrix.push_back(newRow);
   }
   
@@ -228,6 +185,22 @@ polyjam::generator::CMatrix::getSymbolicPolynomial2( int row )
   return result;
 }
 
+polyjam::core::Poly
+polyjam::generator::CMatrix::getSymbolicPolynomial2( int row, const std::vector<int> & columnLabels )
+{
+  core::Poly result = core::Poly::zeroS(_monomials.front().dimensions());
+  
+  for( size_t col = 0; col < _monomials.size(); col++ )
+  {
+    if( !((*(_matrix[row]))[col].isZero()) )
+    {
+      result += core::Term(core::Coefficient((int) (columnLabels[col] + 1),fields::Field::Sym),_monomials[col]);
+    }
+  }
+  
+  return result;
+}
+
 polyjam::generator::CMatrix::polynomials_t
 polyjam::generator::CMatrix::getPolynomials()
 {
@@ -261,6 +234,17 @@ polyjam::generator::CMatrix::getSymbolicPolynomials2()
   return polynomials;
 }
 
+polyjam::generator::CMatrix::polynomials_t
+polyjam::generator::CMatrix::getSymbolicPolynomials2( const std::vector<int> & columnLabels )
+{
+  polynomials_t polynomials;
+  
+  for( size_t i = 0; i < _matrix.size(); i++ )
+    polynomials.push_back(new core::Poly(getSymbolicPolynomial2(i,columnLabels)));
+  
+  return polynomials;
+}
+
 //verifiers
 bool
 polyjam::generator::CMatrix::contains( const polynomials_t & polynomials )
@@ -332,7 +316,8 @@ polyjam::generator::CMatrix::save( const std::string & name, const std::string &
 //internal
 polyjam::generator::CMatrix::CMatrix( cmatrix_t & matrix, monomials_t & monomials ) :
     _matrix(matrix),
-    _monomials(monomials)
+    _monomials(monomials),
+    _operations(0)
 {};
 
 void
@@ -342,12 +327,14 @@ polyjam::generator::CMatrix::fillMonomials( const polynomials_t & polynomials )
   //the good thing about a tree is that insertion of new elements is easy,
   //almost like in a list (exponential time). The other thing is that search
   //is also expontential in time.
-  std::set<core::Monomial,Comp> monomialTree;
+  core::MonomialGreater comp(
+      polynomials.front()->leadingTerm().monomial().order() );
+  std::set<core::Monomial,core::MonomialGreater> monomialTree(comp);
   
   polynomials_t::const_iterator polyIter = polynomials.begin();
   while( polyIter != polynomials.end() )
   {
-    std::set<core::Term>::iterator termIter = (*polyIter)->begin();
+    core::Poly::terms_t::iterator termIter = (*polyIter)->begin();
     while( termIter != (*polyIter)->end() )
     {
       monomialTree.insert( termIter->monomial() );
@@ -361,7 +348,7 @@ polyjam::generator::CMatrix::fillMonomials( const polynomials_t & polynomials )
   
   //efficiently convert the tree into a vector
   _monomials.reserve(cols);
-  std::set<core::Monomial,Comp>::iterator treeIter = monomialTree.begin();
+  std::set<core::Monomial,core::MonomialGreater>::iterator treeIter = monomialTree.begin();
   while( treeIter != monomialTree.end() )
   {
     _monomials.push_back(*treeIter);
@@ -385,7 +372,7 @@ polyjam::generator::CMatrix::fillMatrix( const polynomials_t & polynomials, bool
     crow_t* newRow = new crow_t();
     newRow->reserve(cols);
     for( int x = 0; x < cols; x++ )
-      newRow->push_back(zero.clone());
+      newRow->push_back(zero);
     _matrix.push_back(newRow);
   }
   
@@ -395,10 +382,11 @@ polyjam::generator::CMatrix::fillMatrix( const polynomials_t & polynomials, bool
   {
     polynomials_t::const_iterator polyIter = polynomials.begin();
     int row = 0;
-    Comp comp;
+    core::MonomialGreater comp(
+        polynomials.front()->leadingTerm().monomial().order() );
     while( polyIter != polynomials.end() )
     {
-      std::set<core::Term>::iterator termIter = (*polyIter)->begin();
+      core::Poly::terms_t::iterator termIter = (*polyIter)->begin();
       monomials_t::iterator colIter = _monomials.begin();
       while( termIter != (*polyIter)->end() )
       {
@@ -407,7 +395,7 @@ polyjam::generator::CMatrix::fillMatrix( const polynomials_t & polynomials, bool
             colIter, _monomials.end(), termIter->monomial(), comp );
         int col = colIter - _monomials.begin();
         
-        (*(_matrix[row]))[col] = termIter->coefficient().clone();
+        (*(_matrix[row]))[col] = termIter->coefficient();
         ++termIter;
       }
       ++polyIter;
@@ -421,7 +409,7 @@ polyjam::generator::CMatrix::fillMatrix( const polynomials_t & polynomials, bool
 
     while( polyIter != polynomials.end() )
     {
-      std::set<core::Term>::iterator termIter = (*polyIter)->begin();
+      core::Poly::terms_t::iterator termIter = (*polyIter)->begin();
       
       while( termIter != (*polyIter)->end() )
       {
@@ -431,7 +419,7 @@ polyjam::generator::CMatrix::fillMatrix( const polynomials_t & polynomials, bool
           colIter++;
         int col = colIter - _monomials.begin();
         
-        (*(_matrix[row]))[col] = termIter->coefficient().clone();
+        (*(_matrix[row]))[col] = termIter->coefficient();
         ++termIter;
       }
       ++polyIter;
@@ -440,3 +428,111 @@ polyjam::generator::CMatrix::fillMatrix( const polynomials_t & polynomials, bool
   }
 }
 
+void
+polyjam::generator::CMatrix::fillExpanded(
+    const polynomials_t & polynomials, const eqs_t & equations, bool collectMonomials,
+    core::MonomialTable * table )
+{
+  core::MonomialTable localTable( polynomials.front()->leadingTerm().monomial().order() );
+  if( table == NULL )
+    table = &localTable;
+  
+  //the polynomials by index, and the ids of their monomials (once they are used)
+  std::vector<const core::Poly*> base( polynomials.begin(), polynomials.end() );
+  std::vector< std::vector<size_t> > termIds( base.size() );
+  
+  //the column of each id (-1 if not a column), either given by the order or
+  //collected on the way
+  std::vector<int> columns;
+  std::vector<size_t> collected;
+  if( !collectMonomials )
+  {
+    for( size_t col = 0; col < _monomials.size(); col++ )
+    {
+      size_t id = table->insert(_monomials[col]);
+      if( id >= columns.size() )
+        columns.resize(id+1,-1);
+      columns[id] = col;
+    }
+  }
+  
+  //shift the terms of the polynomials by the expanders directly into sparse
+  //rows, instead of creating all the expanded polynomials
+  typedef std::vector< std::pair<size_t,core::Coefficient> > srow_t;
+  std::vector<srow_t> sparseRows(equations.size());
+  for( size_t row = 0; row < equations.size(); row++ )
+  {
+    size_t index = equations[row].first;
+    const core::Poly & polynomial = *(base[index]);
+    if( termIds[index].empty() )
+    {
+      core::Poly::terms_t::iterator termIter = polynomial.begin();
+      while( termIter != polynomial.end() )
+      {
+        termIds[index].push_back( table->insert(termIter->monomial()) );
+        ++termIter;
+      }
+    }
+    
+    size_t expander = table->insert(equations[row].second);
+    srow_t & sparseRow = sparseRows[row];
+    sparseRow.reserve(polynomial.size());
+    
+    core::Poly::terms_t::iterator termIter = polynomial.begin();
+    for( size_t term = 0; termIter != polynomial.end(); term++, ++termIter )
+    {
+      size_t shifted = table->multiply( termIds[index][term], expander );
+      if( shifted >= columns.size() )
+        columns.resize(shifted+1,-1);
+      if( columns[shifted] < 0 )
+      {
+        if( !collectMonomials )
+        {
+          std::cout << "Error: monomial " << table->monomial(shifted).getString(false);
+          std::cout << " is not part of the given order" << std::endl;
+          continue;
+        }
+        columns[shifted] = collected.size();
+        collected.push_back(shifted);
+      }
+      sparseRow.push_back( std::make_pair( (size_t) columns[shifted], termIter->coefficient() ) );
+    }
+  }
+  
+  //sort the collected monomials by their rank, and renumber the columns accordingly
+  if( collectMonomials )
+  {
+    std::vector<size_t> sorted(collected.size());
+    for( size_t i = 0; i < sorted.size(); i++ )
+      sorted[i] = i;
+    std::sort( sorted.begin(), sorted.end(),
+        [&]( size_t i1, size_t i2 ) { return table->rank(collected[i1]) < table->rank(collected[i2]); } );
+    
+    std::vector<size_t> newIndex(collected.size());
+    _monomials.reserve(collected.size());
+    for( size_t i = 0; i < sorted.size(); i++ )
+    {
+      newIndex[sorted[i]] = i;
+      _monomials.push_back(table->monomial(collected[sorted[i]]));
+    }
+    
+    for( size_t row = 0; row < sparseRows.size(); row++ )
+    {
+      for( size_t i = 0; i < sparseRows[row].size(); i++ )
+        sparseRows[row][i].first = newIndex[sparseRows[row][i].first];
+    }
+  }
+  
+  //finally setup the matrix with zero coefficients and scatter the rows
+  core::Coefficient zero(
+      polynomials.front()->leadingTerm().coefficient().zero() );
+  
+  _matrix.reserve(sparseRows.size());
+  for( size_t row = 0; row < sparseRows.size(); row++ )
+  {
+    crow_t* newRow = new crow_t( _monomials.size(), zero );
+    for( size_t i = 0; i < sparseRows[row].size(); i++ )
+      (*newRow)[sparseRows[row][i].first] = sparseRows[row][i].second;
+    _matrix.push_back(newRow);
+  }
+}
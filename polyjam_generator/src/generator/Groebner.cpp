@@ -0,0 +1,631 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#include <polyjam/generator/Groebner.hpp>
+#include <polyjam/fields/Zp.hpp>
+#include <algorithm>
+#include <set>
+#include <list>
+#include <sstream>
+
+using namespace std;
+
+namespace
+{
+
+typedef polyjam::generator::Groebner::exponents_t exponents_t;
+
+unsigned int
+totalDegree( const exponents_t & a )
+{
+  unsigned int degree = 0;
+  for( size_t i = 0; i < a.size(); i++ )
+    degree += a[i];
+  return degree;
+}
+
+//GRevLex comparison (same as in Monomial), returns 1 if a>b, -1 if a<b, 0 if equal
+int
+grevlexComparison( const exponents_t & a, const exponents_t & b )
+{
+  unsigned int degreeA = totalDegree(a);
+  unsigned int degreeB = totalDegree(b);
+  if( degreeA > degreeB )
+    return 1;
+  if( degreeA < degreeB )
+    return -1;
+
+  for( size_t i = a.size(); i > 0; i-- )
+  {
+    if( a[i-1] < b[i-1] )
+      return 1;
+    if( a[i-1] > b[i-1] )
+      return -1;
+  }
+  return 0;
+}
+
+bool
+termGreater( const polyjam::generator::Groebner::term_t & a, const polyjam::generator::Groebner::term_t & b )
+{
+  return grevlexComparison(a.first,b.first) > 0;
+}
+
+//does a divide b?
+bool
+isDivisor( const exponents_t & a, const exponents_t & b )
+{
+  for( size_t i = 0; i < a.size(); i++ )
+  {
+    if( a[i] > b[i] )
+      return false;
+  }
+  return true;
+}
+
+bool
+coprime( const exponents_t & a, const exponents_t & b )
+{
+  for( size_t i = 0; i < a.size(); i++ )
+  {
+    if( a[i] > 0 && b[i] > 0 )
+      return false;
+  }
+  return true;
+}
+
+exponents_t
+leastCommonMultiple( const exponents_t & a, const exponents_t & b )
+{
+  exponents_t result(a.size());
+  for( size_t i = 0; i < a.size(); i++ )
+    result[i] = max(a[i],b[i]);
+  return result;
+}
+
+//b divided by a, assuming that a divides b
+exponents_t
+quotient( const exponents_t & b, const exponents_t & a )
+{
+  exponents_t result(a.size());
+  for( size_t i = 0; i < a.size(); i++ )
+    result[i] = b[i] - a[i];
+  return result;
+}
+
+exponents_t
+product( const exponents_t & a, const exponents_t & b )
+{
+  exponents_t result(a.size());
+  for( size_t i = 0; i < a.size(); i++ )
+    result[i] = a[i] + b[i];
+  return result;
+}
+
+}
+
+polyjam::generator::Groebner::Groebner()
+{
+  _numberVariables = 0;
+  _characteristic = 0;
+  _dimension = -1;
+  _degree = -1;
+}
+
+polyjam::generator::Groebner::~Groebner()
+{
+}
+
+void
+polyjam::generator::Groebner::addPoly( const core::Poly & poly )
+{
+  const core::Coefficient & coeff = poly.leadingTerm().coefficient();
+
+  if( coeff.kind() != fields::Field::Zp )
+  {
+    cout << "Error: cannot compute Groebner basis of non-Zp polynomials" << endl;
+    cout << "Maybe you forgot to properly set the dominant index?" << endl;
+    return;
+  }
+
+  if( _equations.empty() )
+  {
+    _numberVariables = poly.leadingTerm().monomial().dimensions();
+    _characteristic = coeff.characteristic();
+  }
+  else
+  {
+    if(
+        _numberVariables != poly.leadingTerm().monomial().dimensions() ||
+        _characteristic != coeff.characteristic() )
+    {
+      cout << "Error: dimensions or characteristic don't match" << endl;
+      return;
+    }
+  }
+
+  poly_t newPoly;
+  core::Poly::terms_t::iterator it = poly.begin();
+  while( it != poly.end() )
+  {
+    unsigned int value = it->coefficient().zpValue();
+    if( value != 0 )
+      newPoly.push_back( term_t( it->monomial().exponents(), value ) );
+    it++;
+  }
+  sort( newPoly.begin(), newPoly.end(), termGreater );
+
+  if( !newPoly.empty() )
+    _equations.push_back(newPoly);
+}
+
+std::string
+polyjam::generator::Groebner::canonicalForm() const
+{
+  //write each equation in monic form, and sort them such that the order of
+  //the equations does not matter
+  vector<string> equations;
+  for( size_t i = 0; i < _equations.size(); i++ )
+  {
+    poly_t poly = _equations[i];
+    makeMonic(poly);
+
+    stringstream equation;
+    for( size_t k = 0; k < poly.size(); k++ )
+    {
+      equation << poly[k].second << "*";
+      for( size_t v = 0; v < _numberVariables; v++ )
+        equation << (v > 0 ? "," : "") << poly[k].first[v];
+      equation << " ";
+    }
+    equations.push_back(equation.str());
+  }
+  sort( equations.begin(), equations.end() );
+
+  stringstream form;
+  form << "ZZ/" << _characteristic << "[" << _numberVariables << "]";
+  for( size_t i = 0; i < equations.size(); i++ )
+    form << "|" << equations[i];
+  return form.str();
+}
+
+bool
+polyjam::generator::Groebner::compute()
+{
+  _basis.clear();
+  _sugar.clear();
+  _active.clear();
+  _standardMonomials.clear();
+
+  if( _equations.empty() )
+  {
+    cout << "Error: there are no equations for the Groebner basis computation" << endl;
+    return false;
+  }
+
+  vector< pair<size_t,size_t> > pairs;
+  bool unitIdeal = false;
+
+  //add the (inter-reduced) input equations
+  for( size_t i = 0; i < _equations.size() && !unitIdeal; i++ )
+  {
+    poly_t poly = _equations[i];
+    reduce(poly);
+    if( poly.empty() )
+      continue;
+
+    makeMonic(poly);
+    _basis.push_back(poly);
+    _sugar.push_back(totalDegree(poly.front().first));
+    _active.push_back(true);
+    update( pairs, _basis.size()-1 );
+
+    if( totalDegree(poly.front().first) == 0 )
+      unitIdeal = true;
+  }
+
+  //Buchberger's algorithm, always treat the pair with the lowest sugar first
+  while( !pairs.empty() && !unitIdeal )
+  {
+    size_t best = 0;
+    unsigned int bestSugar = 0;
+    unsigned int bestDegree = 0;
+    for( size_t p = 0; p < pairs.size(); p++ )
+    {
+      const exponents_t & lm1 = _basis[pairs[p].first].front().first;
+      const exponents_t & lm2 = _basis[pairs[p].second].front().first;
+      unsigned int lcmDegree = totalDegree(leastCommonMultiple(lm1,lm2));
+      unsigned int sugar = max(
+          _sugar[pairs[p].first]  + lcmDegree - totalDegree(lm1),
+          _sugar[pairs[p].second] + lcmDegree - totalDegree(lm2) );
+
+      if( p == 0 || sugar < bestSugar || (sugar == bestSugar && lcmDegree < bestDegree) )
+      {
+        best = p;
+        bestSugar = sugar;
+        bestDegree = lcmDegree;
+      }
+    }
+
+    pair<size_t,size_t> selected = pairs[best];
+    pairs.erase(pairs.begin()+best);
+
+    poly_t poly = sPolynomial(selected.first,selected.second);
+    reduce(poly);
+    if( poly.empty() )
+      continue;
+
+    makeMonic(poly);
+    _basis.push_back(poly);
+    _sugar.push_back(bestSugar);
+    _active.push_back(true);
+    update( pairs, _basis.size()-1 );
+
+    if( totalDegree(poly.front().first) == 0 )
+      unitIdeal = true;
+  }
+
+  analyse();
+  return true;
+}
+
+int
+polyjam::generator::Groebner::dimension() const
+{
+  return _dimension;
+}
+
+int
+polyjam::generator::Groebner::degree() const
+{
+  return _degree;
+}
+
+const std::vector<polyjam::core::Monomial> &
+polyjam::generator::Groebner::standardMonomials() const
+{
+  return _standardMonomials;
+}
+
+std::vector<polyjam::core::Monomial>
+polyjam::generator::Groebner::leadingMonomials() const
+{
+  vector<core::Monomial> monomials;
+  for( size_t i = 0; i < _basis.size(); i++ )
+  {
+    if( _active[i] )
+      monomials.push_back( core::Monomial(_basis[i].front().first) );
+  }
+  return monomials;
+}
+
+unsigned int
+polyjam::generator::Groebner::multiply( unsigned int a, unsigned int b ) const
+{
+  return (unsigned int) ( ((unsigned long long) a * b) % _characteristic );
+}
+
+unsigned int
+polyjam::generator::Groebner::inverse( unsigned int a ) const
+{
+  //Fermat's little theorem: a^(p-2) = a^(-1)
+  unsigned int result = 1;
+  unsigned int base = a % _characteristic;
+  unsigned int exponent = _characteristic - 2;
+  while( exponent > 0 )
+  {
+    if( exponent & 1 )
+      result = multiply(result,base);
+    base = multiply(base,base);
+    exponent >>= 1;
+  }
+  return result;
+}
+
+void
+polyjam::generator::Groebner::makeMonic( poly_t & poly ) const
+{
+  unsigned int factor = inverse(poly.front().second);
+  for( size_t i = 0; i < poly.size(); i++ )
+    poly[i].second = multiply(poly[i].second,factor);
+}
+
+void
+polyjam::generator::Groebner::subtractMultiple(
+    poly_t & poly,
+    unsigned int factor,
+    const exponents_t & multiplier,
+    const poly_t & reducer ) const
+{
+  //merge the two sorted term lists
+  poly_t result;
+  result.reserve( poly.size() + reducer.size() );
+
+  size_t i = 0;
+  size_t j = 0;
+  while( i < poly.size() || j < reducer.size() )
+  {
+    if( j == reducer.size() )
+    {
+      result.push_back(poly[i++]);
+      continue;
+    }
+
+    exponents_t monomial = product(multiplier,reducer[j].first);
+    unsigned int value = _characteristic - multiply(factor,reducer[j].second);
+    if( value == _characteristic )
+      value = 0;
+
+    int comparison = -1;
+    if( i < poly.size() )
+      comparison = grevlexComparison(poly[i].first,monomial);
+
+    if( comparison > 0 )
+    {
+      result.push_back(poly[i++]);
+    }
+    else if( comparison < 0 )
+    {
+      if( value != 0 )
+        result.push_back( term_t(monomial,value) );
+      j++;
+    }
+    else
+    {
+      unsigned int sum = (poly[i].second + value) % _characteristic;
+      if( sum != 0 )
+        result.push_back( term_t(monomial,sum) );
+      i++;
+      j++;
+    }
+  }
+
+  poly.swap(result);
+}
+
+int
+polyjam::generator::Groebner::findReducer( const exponents_t & monomial ) const
+{
+  for( size_t i = 0; i < _basis.size(); i++ )
+  {
+    if( _active[i] && isDivisor(_basis[i].front().first,monomial) )
+      return i;
+  }
+  return -1;
+}
+
+void
+polyjam::generator::Groebner::reduce( poly_t & poly ) const
+{
+  //full reduction: the terms that cannot be reduced are moved to the result
+  poly_t result;
+  while( !poly.empty() )
+  {
+    int reducer = findReducer(poly.front().first);
+    if( reducer < 0 )
+    {
+      result.push_back(poly.front());
+      poly.erase(poly.begin());
+      continue;
+    }
+
+    exponents_t multiplier = quotient(poly.front().first,_basis[reducer].front().first);
+    subtractMultiple(poly,poly.front().second,multiplier,_basis[reducer]);
+  }
+  poly.swap(result);
+}
+
+polyjam::generator::Groebner::poly_t
+polyjam::generator::Groebner::sPolynomial( size_t i, size_t j ) const
+{
+  //both polynomials are monic
+  const exponents_t & lm1 = _basis[i].front().first;
+  const exponents_t & lm2 = _basis[j].front().first;
+  exponents_t lcm = leastCommonMultiple(lm1,lm2);
+
+  poly_t result;
+  exponents_t multiplier1 = quotient(lcm,lm1);
+  for( size_t k = 1; k < _basis[i].size(); k++ )
+    result.push_back( term_t( product(multiplier1,_basis[i][k].first), _basis[i][k].second ) );
+
+  poly_t tail2( _basis[j].begin()+1, _basis[j].end() );
+  subtractMultiple( result, 1, quotient(lcm,lm2), tail2 );
+  return result;
+}
+
+void
+polyjam::generator::Groebner::update( std::vector< std::pair<size_t,size_t> > & pairs, size_t h )
+{
+  //Gebauer-Moeller installation of the new pairs
+  const exponents_t & lmh = _basis[h].front().first;
+
+  list<size_t> candidates;
+  for( size_t g = 0; g < h; g++ )
+  {
+    if( _active[g] )
+      candidates.push_back(g);
+  }
+
+  vector<size_t> kept;
+  while( !candidates.empty() )
+  {
+    size_t g1 = candidates.front();
+    candidates.pop_front();
+    const exponents_t & lm1 = _basis[g1].front().first;
+
+    bool keep = coprime(lmh,lm1);
+    if( !keep )
+    {
+      exponents_t lcm1 = leastCommonMultiple(lmh,lm1);
+      keep = true;
+      list<size_t>::iterator it = candidates.begin();
+      while( it != candidates.end() && keep )
+      {
+        if( isDivisor( leastCommonMultiple(lmh,_basis[*it].front().first), lcm1 ) )
+          keep = false;
+        it++;
+      }
+      for( size_t k = 0; k < kept.size() && keep; k++ )
+      {
+        if( isDivisor( leastCommonMultiple(lmh,_basis[kept[k]].front().first), lcm1 ) )
+          keep = false;
+      }
+    }
+
+    if(keep)
+      kept.push_back(g1);
+  }
+
+  //remove the old pairs that are made redundant by h (chain criterion)
+  vector< pair<size_t,size_t> > newPairs;
+  for( size_t p = 0; p < pairs.size(); p++ )
+  {
+    const exponents_t & lm1 = _basis[pairs[p].first].front().first;
+    const exponents_t & lm2 = _basis[pairs[p].second].front().first;
+    exponents_t lcm12 = leastCommonMultiple(lm1,lm2);
+
+    if( !isDivisor(lmh,lcm12) ||
+        leastCommonMultiple(lm1,lmh) == lcm12 ||
+        leastCommonMultiple(lm2,lmh) == lcm12 )
+      newPairs.push_back(pairs[p]);
+  }
+
+  //add the new pairs, except those with coprime leading monomials (product criterion)
+  for( size_t k = 0; k < kept.size(); k++ )
+  {
+    if( !coprime(lmh,_basis[kept[k]].front().first) )
+      newPairs.push_back( pair<size_t,size_t>(kept[k],h) );
+  }
+  pairs.swap(newPairs);
+
+  //finally, the elements whose leading monomial is divisible by the new one are no longer needed
+  for( size_t g = 0; g < h; g++ )
+  {
+    if( _active[g] && isDivisor(lmh,_basis[g].front().first) )
+      _active[g] = false;
+  }
+}
+
+void
+polyjam::generator::Groebner::analyse()
+{
+  vector<exponents_t> leading;
+  for( size_t i = 0; i < _basis.size(); i++ )
+  {
+    if( _active[i] )
+      leading.push_back(_basis[i].front().first);
+  }
+
+  //the unit ideal
+  for( size_t i = 0; i < leading.size(); i++ )
+  {
+    if( totalDegree(leading[i]) == 0 )
+    {
+      _dimension = -1;
+      _degree = 0;
+      return;
+    }
+  }
+
+  //the dimension is the size of the largest set of variables that does not
+  //contain the support of any leading monomial
+  vector<unsigned long> supports;
+  for( size_t i = 0; i < leading.size(); i++ )
+  {
+    unsigned long support = 0;
+    for( size_t v = 0; v < _numberVariables; v++ )
+    {
+      if( leading[i][v] > 0 )
+        support |= (1ul << v);
+    }
+    supports.push_back(support);
+  }
+
+  //check for zero-dimensionality first (a pure power for every variable)
+  bool zeroDimensional = true;
+  for( size_t v = 0; v < _numberVariables && zeroDimensional; v++ )
+  {
+    bool found = false;
+    for( size_t i = 0; i < supports.size() && !found; i++ )
+      found = (supports[i] == (1ul << v));
+    zeroDimensional = found;
+  }
+
+  if( !zeroDimensional )
+  {
+    if( _numberVariables >= 8 * sizeof(unsigned long) )
+    {
+      cout << "Error: too many variables for computing the dimension of the ideal" << endl;
+      _dimension = _numberVariables;
+      _degree = -1;
+      return;
+    }
+
+    _dimension = 0;
+    for( unsigned long set = 1; set < (1ul << _numberVariables); set++ )
+    {
+      int size = 0;
+      for( size_t v = 0; v < _numberVariables; v++ )
+      {
+        if( set & (1ul << v) )
+          size++;
+      }
+      if( size <= _dimension )
+        continue;
+
+      bool independent = true;
+      for( size_t i = 0; i < supports.size() && independent; i++ )
+        independent = ((supports[i] & set) != supports[i]);
+      if( independent )
+        _dimension = size;
+    }
+    _degree = -1;
+    return;
+  }
+
+  //enumerate the standard monomials, starting from one
+  _dimension = 0;
+  set<exponents_t> visited;
+  list<exponents_t> queue;
+  queue.push_back( exponents_t(_numberVariables,0) );
+  visited.insert( queue.front() );
+  while( !queue.empty() )
+  {
+    exponents_t monomial = queue.front();
+    queue.pop_front();
+    _standardMonomials.push_back( core::Monomial(monomial) );
+
+    for( size_t v = 0; v < _numberVariables; v++ )
+    {
+      exponents_t next = monomial;
+      next[v]++;
+      if( visited.count(next) )
+        continue;
+      visited.insert(next);
+
+      bool standard = true;
+      for( size_t i = 0; i < leading.size() && standard; i++ )
+        standard = !isDivisor(leading[i],next);
+      if( standard )
+        queue.push_back(next);
+    }
+  }
+  _degree = _standardMonomials.size();
+}
@@ -0,0 +1,235 @@
+/*************************************************************************
+ *                                                                       *
+ * polyjam, a polynomial solver generator for C++                        *
+ * Copyright (C) 2015 Laurent Kneip, The Australian National University  *
+ *                                                                       *
+ * This program is free software: you can redistribute it and/or modify  *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * This program is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have received a copy of the GNU General Public License     *
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                       *
+ *************************************************************************/
+
+#include <polyjam/generator/Profiler.hpp>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+using namespace std;
+
+namespace
+{
+
+//escape a string for JSON
+string
+quoted( const string & input )
+{
+  string output("\"");
+  for( size_t i = 0; i < input.size(); i++ )
+  {
+    if( input[i] == '"' || input[i] == '\\' )
+      output += '\\';
+    output += input[i];
+  }
+  output += "\"";
+  return output;
+}
+
+void
+writeValues( ofstream & file, const vector<polyjam::generator::Profiler::value_t> & values )
+{
+  file << "{";
+  for( size_t i = 0; i < values.size(); i++ )
+  {
+    if( i > 0 )
+      file << ",";
+    file << quoted(values[i].first) << ":" << values[i].second;
+  }
+  file << "}";
+}
+
+}
+
+polyjam::generator::Profiler::Profiler()
+{
+  _origin = wallTime();
+}
+
+polyjam::generator::Profiler::~Profiler()
+{}
+
+void
+polyjam::generator::Profiler::begin( const string & name )
+{
+  Phase phase;
+  phase.name = name;
+  phase.depth = _running.size();
+  phase.start = wallTime() - _origin;
+  phase.wall = 0.0;
+  phase.cpu = 0.0;
+  phase.peakRss = 0;
+  _running.push_back(_phases.size());
+  _cpuStart.push_back(cpuTime());
+  _countersStart.push_back(core::Counters::snapshot());
+  _phases.push_back(phase);
+}
+
+void
+polyjam::generator::Profiler::end()
+{
+  if( _running.empty() )
+  {
+    cout << "Error: there is no phase to end" << endl;
+    return;
+  }
+
+  Phase & phase = _phases[_running.back()];
+  phase.wall = wallTime() - _origin - phase.start;
+  phase.cpu = cpuTime() - _cpuStart.back();
+  phase.peakRss = peakRss();
+
+  if( core::Counters::enabled() )
+  {
+    core::Counters counts = core::Counters::snapshot() - _countersStart.back();
+    phase.values.push_back(value_t("field additions",counts.fieldAdditions));
+    phase.values.push_back(value_t("field subtractions",counts.fieldSubtractions));
+    phase.values.push_back(value_t("field multiplications",counts.fieldMultiplications));
+    phase.values.push_back(value_t("field divisions",counts.fieldDivisions));
+    phase.values.push_back(value_t("field negations",counts.fieldNegations));
+    phase.values.push_back(value_t("field inversions",counts.fieldInversions));
+    phase.values.push_back(value_t("field allocations",counts.fieldAllocations));
+    phase.values.push_back(value_t("coefficient clones",counts.coefficientClones));
+    phase.values.push_back(value_t("term constructions",counts.termConstructions));
+    phase.values.push_back(value_t("term insertions",counts.termInsertions));
+  }
+
+  _running.pop_back();
+  _cpuStart.pop_back();
+  _countersStart.pop_back();
+}
+
+void
+polyjam::generator::Profiler::record( const string & key, double value )
+{
+  if( _running.empty() )
+  {
+    cout << "Error: cannot record " << key << " outside of a phase" << endl;
+    return;
+  }
+  _phases[_running.back()].values.push_back(value_t(key,value));
+}
+
+void
+polyjam::generator::Profiler::record( const string & prefix, CMatrix & matrix )
+{
+  record( prefix + " rows", matrix.rows() );
+  record( prefix + " cols", matrix.cols() );
+  record( prefix + " nonzeros", matrix.nonzeros() );
+  record( prefix + " operations", matrix.operations() );
+}
+
+const vector<polyjam::generator::Profiler::Phase> &
+polyjam::generator::Profiler::phases() const
+{
+  return _phases;
+}
+
+void
+polyjam::generator::Profiler::saveJson( const string & fileName ) const
+{
+  ofstream file(fileName.c_str());
+  if( !file.is_open() )
+  {
+    cout << "Error: could not write the profile " << fileName << endl;
+    return;
+  }
+  file.precision(12);
+
+  file << "{\"phases\":[" << endl;
+  for( size_t i = 0; i < _phases.size(); i++ )
+  {
+    const Phase & phase = _phases[i];
+    file << "{\"name\":" << quoted(phase.name);
+    file << ",\"depth\":" << phase.depth;
+    file << ",\"start_ms\":" << phase.start;
+    file << ",\"wall_ms\":" << phase.wall;
+    file << ",\"cpu_ms\":" << phase.cpu;
+    file << ",\"peak_rss_kb\":" << phase.peakRss;
+    file << ",\"values\":";
+    writeValues(file,phase.values);
+    file << "}";
+    if( i + 1 < _phases.size() )
+      file << ",";
+    file << endl;
+  }
+  file << "]}" << endl;
+}
+
+void
+polyjam::generator::Profiler::saveTrace( const string & fileName ) const
+{
+  ofstream file(fileName.c_str());
+  if( !file.is_open() )
+  {
+    cout << "Error: could not write the trace " << fileName << endl;
+    return;
+  }
+  file.precision(12);
+
+  //complete events ("X") in microseconds
+  file << "{\"traceEvents\":[" << endl;
+  for( size_t i = 0; i < _phases.size(); i++ )
+  {
+    const Phase & phase = _phases[i];
+    vector<value_t> args = phase.values;
+    args.push_back(value_t("cpu_ms",phase.cpu));
+    args.push_back(value_t("peak_rss_kb",phase.peakRss));
+
+    file << "{\"name\":" << quoted(phase.name);
+    file << ",\"ph\":\"X\",\"pid\":1,\"tid\":1";
+    file << ",\"ts\":" << (long long) (phase.start * 1000.0);
+    file << ",\"dur\":" << (long long) (phase.wall * 1000.0);
+    file << ",\"args\":";
+    writeValues(file,args);
+    file << "}";
+    if( i + 1 < _phases.size() )
+      file << ",";
+    file << endl;
+  }
+  file << "],\"displayTimeUnit\":\"ms\"}" << endl;
+}
+
+double
+polyjam::generator::Profiler::wallTime() const
+{
+  struct timeval now;
+  gettimeofday( &now, 0 );
+  return now.tv_sec * 1000.0 + now.tv_usec / 1000.0;
+}
+
+double
+polyjam::generator::Profiler::cpuTime() const
+{
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+  return
+      ( usage.ru_utime.tv_sec + usage.ru_stime.tv_sec ) * 1000.0 +
+      ( usage.ru_utime.tv_usec + usage.ru_stime.tv_usec ) / 1000.0;
+}
+
+long
+polyjam::generator::Profiler::peakRss() const
+{
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+  return usage.ru_maxrss;
+}
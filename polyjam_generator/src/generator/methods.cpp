@@ -22,6 +22,205 @@
 #include <polyjam/generator/methods.hpp>
 #include <sstream>
 #include <fstream>
+#include <algorithm>
+#include <unordered_set>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <ctime>
+#include <cstdio>
+#include <stdint.h>
+#include <unistd.h>
+
+namespace
+{
+
+typedef std::unordered_set<polyjam::core::Monomial,polyjam::core::MonomialHash> monomialSet_t;
+
+//the leading monomials of the polynomials we need for the Action matrix
+std::vector<polyjam::core::Monomial>
+actionLeadingMonomials(
+    const std::vector<polyjam::core::Monomial> & baseMonomials,
+    const polyjam::core::Monomial & multiplier )
+{
+  monomialSet_t baseSet( baseMonomials.begin(), baseMonomials.end() );
+  std::vector<polyjam::core::Monomial> leadingMonomials;
+  for( size_t i = 0; i < baseMonomials.size(); i++ ) {
+    polyjam::core::Monomial temp = baseMonomials[i] * multiplier;
+    if( !baseSet.count(temp) )
+      leadingMonomials.push_back(temp);
+  }
+  return leadingMonomials;
+}
+
+//check if the reduced polynomials contain all polynomials needed for the Action matrix
+bool
+containsActionPolynomials(
+    const std::list<polyjam::core::Poly*> & reducedPolynomials,
+    const std::vector<polyjam::core::Monomial> & leadingMonomials,
+    const monomialSet_t & baseSet )
+{
+  //index the reduced polynomials by their leading monomial (unique after the reduction)
+  std::unordered_map<polyjam::core::Monomial,polyjam::core::Poly*,polyjam::core::MonomialHash> leadingIndex;
+  std::list<polyjam::core::Poly*>::const_iterator polysIterator = reducedPolynomials.begin();
+  while( polysIterator != reducedPolynomials.end() ) {
+    leadingIndex[(*polysIterator)->leadingTerm().monomial()] = *polysIterator;
+    polysIterator++;
+  }
+
+  for( size_t i = 0; i < leadingMonomials.size(); i++ ) {
+    auto leadingIter = leadingIndex.find(leadingMonomials[i]);
+    if( leadingIter == leadingIndex.end() )
+      return false;
+
+    polyjam::core::Poly::terms_t::iterator monoIter = leadingIter->second->begin();
+    monoIter++;
+    while( monoIter != leadingIter->second->end() ) {
+      if( !baseSet.count(monoIter->monomial()) )
+        return false;
+      monoIter++;
+    }
+  }
+  return true;
+}
+
+//raw binary input and output for the checkpoints
+template<typename T>
+void
+writeBinary( std::ostream & stream, T value )
+{
+  stream.write( (const char*) &value, sizeof(T) );
+}
+
+template<typename T>
+bool
+readBinary( std::istream & stream, T & value )
+{
+  stream.read( (char*) &value, sizeof(T) );
+  return (bool) stream;
+}
+
+//the terms of Zp polynomials as value and exponents
+void
+writePolynomials( std::ostream & stream, const std::list<polyjam::core::Poly*> & polynomials )
+{
+  writeBinary<uint32_t>( stream, polynomials.size() );
+  std::list<polyjam::core::Poly*>::const_iterator it = polynomials.begin();
+  while( it != polynomials.end() ) {
+    writeBinary<uint32_t>( stream, (*it)->size() );
+    polyjam::core::Poly::terms_t::iterator term = (*it)->begin();
+    while( term != (*it)->end() ) {
+      writeBinary<uint32_t>( stream, term->coefficient().zpValue() );
+      const std::vector<unsigned int> & exponents = term->monomial().exponents();
+      for( size_t k = 0; k < exponents.size(); k++ )
+        writeBinary<uint16_t>( stream, exponents[k] );
+      term++;
+    }
+    it++;
+  }
+}
+
+bool
+readPolynomials( std::istream & stream, size_t nu, std::list<polyjam::core::Poly*> & polynomials )
+{
+  uint32_t numberPolynomials;
+  if( !readBinary( stream, numberPolynomials ) )
+    return false;
+  for( uint32_t i = 0; i < numberPolynomials; i++ ) {
+    uint32_t numberTerms;
+    if( !readBinary( stream, numberTerms ) || numberTerms == 0 )
+      return false;
+    polyjam::core::Poly * poly = NULL;
+    for( uint32_t j = 0; j < numberTerms; j++ ) {
+      uint32_t value;
+      if( !readBinary( stream, value ) )
+        break;
+      std::vector<unsigned int> exponents(nu,0);
+      for( size_t k = 0; k < nu; k++ ) {
+        uint16_t exponent = 0;
+        readBinary( stream, exponent );
+        exponents[k] = exponent;
+      }
+      polyjam::core::Term term(
+          polyjam::core::Coefficient( (int) value, polyjam::fields::Field::Zp ),
+          polyjam::core::Monomial(exponents) );
+      if( poly == NULL )
+        poly = new polyjam::core::Poly(term);
+      else
+        (*poly) += term;
+    }
+    if( poly == NULL )
+      return false;
+    polynomials.push_back(poly);
+    if( !stream )
+      return false;
+  }
+  return true;
+}
+
+//split the parameter list of a solver into the types (without const and
+//references) and the names of the parameters
+void
+splitParameters(
+    const std::string & parameters,
+    std::vector<std::string> & types,
+    std::vector<std::string> & names )
+{
+  std::vector<std::string> declarations(1);
+  int depth = 0;
+  for( size_t i = 0; i < parameters.size(); i++ ) {
+    char c = parameters[i];
+    if( c == '<' || c == '(' )
+      depth++;
+    if( c == '>' || c == ')' )
+      depth--;
+    if( c == ',' && depth == 0 )
+      declarations.push_back(std::string());
+    else
+      declarations.back() += c;
+  }
+
+  for( size_t i = 0; i < declarations.size(); i++ ) {
+    std::string declaration = declarations[i];
+    std::replace( declaration.begin(), declaration.end(), '&', ' ' );
+    size_t end = declaration.find_last_not_of(' ');
+    if( end == std::string::npos )
+      continue;
+    size_t start = end;
+    while( start > 0 && (isalnum(declaration[start-1]) || declaration[start-1] == '_') )
+      start--;
+    std::string type = declaration.substr(0,start);
+    size_t constPosition = type.find("const ");
+    if( constPosition != std::string::npos )
+      type.erase(constPosition,6);
+    size_t first = type.find_first_not_of(' ');
+    size_t last = type.find_last_not_of(' ');
+    if( first == std::string::npos )
+      continue;
+    types.push_back( type.substr(first,last-first+1) );
+    names.push_back( declaration.substr(start,end-start+1) );
+  }
+}
+
+//the largest index i in an expression name[i] of the given code (-1 if there is none)
+int
+maximumIndex( const std::string & code, const std::string & name )
+{
+  int maximum = -1;
+  std::string pattern = name + "[";
+  size_t position = code.find(pattern);
+  while( position != std::string::npos ) {
+    if( position == 0 || !(isalnum(code[position-1]) || code[position-1] == '_' || code[position-1] == '.') ) {
+      int index = atoi( code.c_str() + position + pattern.size() );
+      if( index > maximum )
+        maximum = index;
+    }
+    position = code.find(pattern,position+1);
+  }
+  return maximum;
+}
+
+}
 
 polyjam::generator::CMatrix
 polyjam::generator::methods::experiment(
@@ -82,20 +281,7 @@ polyjam::generator::methods::automaticDegreeFinder(
     bool visualization,
     bool consolePrint,
     bool evenOnly ) {
-  std::vector<core::Monomial> leadingMonomials;
-
-  for( size_t i = 0; i < baseMonomials.size(); i++ ) {
-    core::Monomial temp = baseMonomials[i] * multiplier;
-    int index = -1;
-    for( size_t j = 0; j < baseMonomials.size(); j++ ) {
-      if( baseMonomials[j] == temp ) {
-        index = j;
-        break;
-      }
-    }
-    if( index < 0 )
-      leadingMonomials.push_back(temp);
-  }
+  std::vector<core::Monomial> leadingMonomials = actionLeadingMonomials(baseMonomials,multiplier);
   
   if( consolePrint ) {
     std::cout << "The leading Monomials that we are interested in are:" << std::endl;
@@ -103,6 +289,21 @@ polyjam::generator::methods::automaticDegreeFinder(
       std::cout << leadingMonomials[i].getString(false) << std::endl;
   }
   
+  //index the base monomials for quick lookup
+  monomialSet_t baseSet( baseMonomials.begin(), baseMonomials.end() );
+
+  //the pre-elimination is the same for all degrees, so do it only once
+  CMatrix pe_matrix(polynomials);
+  pe_matrix.reduce();
+  std::list<core::Poly*> pePolynomials = pe_matrix.getPolynomials();
+  core::Coefficient one(pePolynomials.front()->leadingTerm().coefficient().one());
+
+  //the reduced polynomials of the last degree span the same space as all the rows
+  //that have been added so far, so we only need to add the rows of the new expanders
+  //and continue the elimination from there
+  std::list<core::Poly*> reducedPolynomials;
+  monomialSet_t usedExpanders;
+
   int expanderDegree = 1;
   if(evenOnly)
     expanderDegree = 0;
@@ -123,68 +324,233 @@ polyjam::generator::methods::automaticDegreeFinder(
       currentExpanders = expanders;
       methods::generateSuperlinearExpanders(currentExpanders,expanderDegree);
     }
-    CMatrix attempt = experiment(polynomials,currentExpanders,visualization,false);
+
+    //the original polynomials are part of the template as well
+    if( usedExpanders.empty() )
+      currentExpanders.insert( currentExpanders.begin(), core::Monomial(expanders.front().dimensions()) );
+
+    std::list<core::Poly*> allPolynomials = reducedPolynomials;
+    for( size_t i = 0; i < currentExpanders.size(); i++ ) {
+      if( !usedExpanders.insert(currentExpanders[i]).second )
+        continue;
+
+      core::Term expander( one, currentExpanders[i] );
+      std::list<core::Poly*>::iterator peIter = pePolynomials.begin();
+      while( peIter != pePolynomials.end() ) {
+        allPolynomials.push_back( new core::Poly( (**peIter) * expander ) );
+        ++peIter;
+      }
+    }
+
+    CMatrix attempt(allPolynomials);
+    if(visualization)
+      attempt.visualize();
+    attempt.reduce();
+    if(visualization)
+      attempt.visualize();
     if(consolePrint)
       std::cout << "Template size: " << attempt.rows() << "x" << attempt.cols() << std::endl;
-    CMatrix::polynomials_t polys = attempt.getPolynomials();
-    
+
+    std::list<core::Poly*>::iterator polysIterator = allPolynomials.begin();
+    while( polysIterator != allPolynomials.end() ) {
+      delete (*polysIterator);
+      polysIterator++;
+    }
+    reducedPolynomials = attempt.getPolynomials();
+
+
     //Now check if all polynomials have been found correctly
-    for( size_t i = 0; i < leadingMonomials.size(); i++ ) {
-      core::Monomial & leadingMonomial = leadingMonomials[i];
-      bool found = false;
-      
-      std::list<core::Poly*>::iterator polysIterator = polys.begin();
-      
-      while( polysIterator != polys.end() ) {
-        if( leadingMonomial == (*polysIterator)->leadingTerm().monomial() ) {
-          bool allOtherContained = true;
-          core::Poly::terms_t::iterator monoIter = (*polysIterator)->begin();
-          monoIter++;
-          while( monoIter != (*polysIterator)->end() )
-          {
-            bool contained = false;
-            
-            //check this monomial
-            for( size_t j = 0; j < baseMonomials.size(); j++ ) {
-              if( monoIter->monomial() == baseMonomials[j] ) {
-                contained = true;
-                break;
-              }
-            }
-            
-            if( !contained ) {
-              allOtherContained = false;
-              break;
-            }
-              
-            monoIter++;
-          }
-          
-          if( allOtherContained ) {
-            found = true;
-            break;
-          }
+    if( !containsActionPolynomials(reducedPolynomials,leadingMonomials,baseSet) ) {
+      std::cout << "Did not find all monomials." << std::endl;
+      allFound = false;
+    }
+  }
+  
+  std::list<core::Poly*>::iterator polysIterator = reducedPolynomials.begin();
+  while( polysIterator != reducedPolynomials.end() ) {
+    delete (*polysIterator);
+    polysIterator++;
+  }
+  polysIterator = pePolynomials.begin();
+  while( polysIterator != pePolynomials.end() ) {
+    delete (*polysIterator);
+    polysIterator++;
+  }
+  
+  std::cout << "Found all monomials." << std::endl;
+  return expanderDegree;
+}
+
+bool
+polyjam::generator::methods::searchTemplate(
+    const std::list<core::Poly*> & polynomials,
+    const std::vector<core::Monomial> & expanders,
+    const std::vector<core::Monomial> & baseMonomials,
+    int maxDegree,
+    core::Monomial & multiplier,
+    int & expanderDegree,
+    bool consolePrint ) {
+  //one candidate per combination of action variable and degree, sorted by degree
+  struct candidate_t {
+    size_t variable;
+    int degree;
+    std::list<core::Poly*> polynomials;
+    bool done;
+    bool success;
+    size_t rows;
+    size_t cols;
+  };
+
+  size_t nu = expanders.size();
+  std::vector<candidate_t> candidates;
+  for( int degree = 2; degree <= maxDegree; degree++ ) {
+    for( size_t variable = 0; variable < nu; variable++ ) {
+      candidate_t candidate;
+      candidate.variable = variable;
+      candidate.degree = degree;
+      candidate.done = false;
+      candidate.success = false;
+      candidate.rows = 0;
+      candidate.cols = 0;
+      candidates.push_back(candidate);
+    }
+  }
+
+  //the polynomials share their coefficients, so every candidate gets its own deep copy
+  for( size_t c = 0; c < candidates.size(); c++ ) {
+    std::list<core::Poly*>::const_iterator it = polynomials.begin();
+    while( it != polynomials.end() ) {
+      candidates[c].polynomials.push_back( new core::Poly( (*it)->clone() ) );
+      it++;
+    }
+  }
+
+  std::mutex mutex;
+  size_t next = 0;
+  //the smallest degree that succeeded so far, larger degrees are not worth trying anymore
+  int bestDegree = maxDegree + 1;
+
+  //the workers create their coefficients in the context of the caller
+  core::GenerationContext & context = core::GenerationContext::current();
+
+  auto worker = [&]() {
+    core::GenerationContext::Scope scope(context);
+    while(true) {
+      size_t c;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        //skip the candidates that have been cancelled in the meantime
+        while( next < candidates.size() && candidates[next].degree > bestDegree ) {
+          candidates[next].done = true;
+          next++;
         }
-        
+        if( next == candidates.size() )
+          return;
+        c = next++;
+      }
+      candidate_t & candidate = candidates[c];
+      //the temporaries of this candidate are released in one shot
+      core::Arena::Scope arena;
+
+      std::vector<unsigned int> action(nu,0);
+      action[candidate.variable] = 1;
+      core::Monomial candidateMultiplier(action);
+      std::vector<core::Monomial> currentExpanders = expanders;
+      generateSuperlinearExpanders(currentExpanders,candidate.degree);
+
+      //pre-eliminate, and check if the degree is sufficient before building the template
+      CMatrix pe_matrix(candidate.polynomials);
+      pe_matrix.reduce();
+      std::list<core::Poly*> pePolynomials = pe_matrix.getPolynomials();
+
+      std::vector<core::Monomial> leadingMonomials = actionLeadingMonomials(baseMonomials,candidateMultiplier);
+      monomialSet_t baseSet( baseMonomials.begin(), baseMonomials.end() );
+      CMatrix attempt( pePolynomials, transformExpanders(currentExpanders,pePolynomials.size()) );
+      attempt.reduce();
+      std::list<core::Poly*> reducedPolynomials = attempt.getPolynomials();
+      bool sufficient = containsActionPolynomials(reducedPolynomials,leadingMonomials,baseSet);
+      std::list<core::Poly*>::iterator polysIterator = reducedPolynomials.begin();
+      while( polysIterator != reducedPolynomials.end() ) {
+        delete (*polysIterator);
         polysIterator++;
       }
-      
-      if( !found ) {
-        std::cout << "Did not find all monomials." << std::endl;
-        allFound = false;
-        break;
+
+      if( sufficient ) {
+        CMatrix::monomials_t finalMonomials;
+        CMatrix::eqs_t finalReorderedEquations;
+        buildTemplate( pePolynomials, currentExpanders, baseMonomials, candidateMultiplier,
+            finalMonomials, finalReorderedEquations, false, false );
+        candidate.rows = finalReorderedEquations.size();
+        candidate.cols = finalMonomials.size();
+      }
+
+      polysIterator = pePolynomials.begin();
+      while( polysIterator != pePolynomials.end() ) {
+        delete (*polysIterator);
+        polysIterator++;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      candidate.done = true;
+      candidate.success = sufficient;
+      if( sufficient && candidate.degree < bestDegree )
+        bestDegree = candidate.degree;
+      if( consolePrint ) {
+        std::cout << "Action variable " << candidate.variable << ", degree " << candidate.degree << ": ";
+        if( sufficient )
+          std::cout << "template size " << candidate.rows << "x" << candidate.cols << std::endl;
+        else
+          std::cout << "degree not sufficient" << std::endl;
       }
     }
-    
-    auto polysIterator = polys.begin();
-    while( polysIterator != polys.end() ) {
+  };
+
+  size_t numberThreads = std::thread::hardware_concurrency();
+  if( numberThreads == 0 )
+    numberThreads = 1;
+  if( numberThreads > candidates.size() )
+    numberThreads = candidates.size();
+  std::vector<std::thread> threads;
+  for( size_t i = 0; i < numberThreads; i++ )
+    threads.push_back( std::thread(worker) );
+  for( size_t i = 0; i < threads.size(); i++ )
+    threads[i].join();
+
+  //pick the smallest successful template
+  int best = -1;
+  for( size_t c = 0; c < candidates.size(); c++ ) {
+    std::list<core::Poly*>::iterator polysIterator = candidates[c].polynomials.begin();
+    while( polysIterator != candidates[c].polynomials.end() ) {
       delete (*polysIterator);
       polysIterator++;
     }
+
+    if( !candidates[c].success )
+      continue;
+    //on ties prefer the lower degree, and then the last variable (the default action variable)
+    if( best < 0 )
+      best = c;
+    else {
+      size_t area = candidates[c].rows * candidates[c].cols;
+      size_t bestArea = candidates[best].rows * candidates[best].cols;
+      if( area < bestArea ||
+          ( area == bestArea && candidates[c].degree == candidates[best].degree ) )
+        best = c;
+    }
   }
-  
-  std::cout << "Found all monomials." << std::endl;
-  return expanderDegree;
+
+  if( best < 0 ) {
+    std::cout << "Error: no template found up to degree " << maxDegree << "." << std::endl;
+    return false;
+  }
+
+  std::vector<unsigned int> action(nu,0);
+  action[candidates[best].variable] = 1;
+  multiplier = core::Monomial(action);
+  expanderDegree = candidates[best].degree;
+  if( consolePrint )
+    std::cout << "Picked action variable " << candidates[best].variable << " with degree " << expanderDegree << std::endl;
+  return true;
 }
 
 void
@@ -199,24 +565,32 @@ polyjam::generator::methods::generate(
     const std::string & solverName,
     const std::string & parameters,
     const std::string & save_path,
+    const core::GenerationContext & context,
     bool visualize )
 {
   /////////////////////////////
-  //general configuration for additional saved data
+  //general configuration for additional saved data (see GenerationContext::Options)
   /////////////////////////////
-  bool saveBeforePreElimination = false; // this is useful for a hand-crafted pre-elimination
-  bool saveAfterPreElimination = false;  // this is useful for a hand-crafted pre-elimination
-  bool saveBeforeElimination = false;    // this is useful for a hand-crafted pre-elimination
-  bool saveAfterElimination = false;     // this is useful if the some manual code is required because Action matrix won't work
-  bool savePolynomials = false;          // this is useful if the some manual code is required because Action matrix won't work
-  bool saveMonomials = false;            // this is useful if the some manual code is required because Action matrix won't work
-
-  bool useGaussJordan = false;
+  const core::GenerationContext::Options & options = context.options();
+  bool saveBeforePreElimination = options.saveBeforePreElimination;
+  bool saveAfterPreElimination = options.saveAfterPreElimination;
+  bool saveBeforeElimination = options.saveBeforeElimination;
+  bool saveAfterElimination = options.saveAfterElimination;
+  bool savePolynomials = options.savePolynomials;
+  bool saveMonomials = options.saveMonomials;
+
+  bool useGaussJordan = options.useGaussJordan;
+  bool realEigenvaluesOnly = options.realEigenvaluesOnly;
+  bool exploitTrivialRows = options.exploitTrivialRows;
   /////////////////////////////
   /////////////////////////////
   /////////////////////////////
 
   std::stringstream code;
+
+  //the timings and sizes of all phases
+  Profiler profiler;
+  profiler.begin("pre-elimination");
   
   //setup the actual pre-elimination matrix
   CMatrix pe_matrix(polynomials);
@@ -228,17 +602,6 @@ polyjam::generator::methods::generate(
 
   std::stringstream M1type;
   M1type << "Eigen::MatrixXd";
-  code << M1type.str() << " M1(" << M1rows << "," << M1cols << ");" << std::endl;
-  code << "M1.fill(0.0);" << std::endl;
-
-  for( int r = 0; r < M1rows; r++ ) {
-    for( int c = 0; c < M1cols; c++ ) {
-      if( !pe_helper(r,c).isZero() )
-        code << "M1(" << r << "," << c << ") = " << pe_helper(r,c).getString(true) << "; ";
-    }
-    code << std::endl;
-  }
-  code << std::endl;
 
   // save the pre-elimination as pictures
   if( visualize )
@@ -247,6 +610,7 @@ polyjam::generator::methods::generate(
     pe_matrix.save( std::string("M1before"), save_path );
 
   pe_matrix.reduce();
+  profiler.record("M1",pe_matrix);
   
   if( visualize )
     pe_matrix.visualize();
@@ -254,12 +618,13 @@ polyjam::generator::methods::generate(
     pe_matrix.save( std::string("M1after"), save_path );
 
   CMatrix::polynomials_t zp_polynomials  = pe_matrix.getPolynomials();
-  //CMatrix::polynomials_t sym_polynomials = pe_matrix.getSymbolicPolynomials( std::string("M1") );
-  CMatrix::polynomials_t sym_polynomials = pe_matrix.getSymbolicPolynomials2();
-  
-  if(useGaussJordan) {
-    code << "polyjam::gaussReduction(M1);" << std::endl << std::endl;
-  } else {
+
+  //the column of M1 in which each monomial is stored (identity unless we shuffle)
+  std::vector<int> M1columns(M1cols);
+  for( int i = 0; i < M1cols; i++ )
+    M1columns[i] = i;
+
+  if(!useGaussJordan) {
     //Gauss reduction may be not stable, due to the numerics it may do something else than what we expect
 
     //start by extracting the reordering indices
@@ -298,292 +663,158 @@ polyjam::generator::methods::generate(
         shufflingIndices.push_back(i);
     }
 
-    //Add the code for the reordering of the matrix
-    code << "//swap the columns to have the leading monomials in the front" << std::endl;
-    code << M1type.str() << " M1temp(" << M1rows << "," << M1cols << ");" << std::endl;
+    //the permutation is known now, so we directly lay out M1 with the leading monomials in the front
     for( int i = 0; i < shufflingIndices.size(); i++ )
-      code << "M1temp.col(" << i << ") = M1.col(" << shufflingIndices[i] << ");" << std::endl;
-    code << std::endl;
+      M1columns[shufflingIndices[i]] = i;
+  }
+
+  //CMatrix::polynomials_t sym_polynomials = pe_matrix.getSymbolicPolynomials( std::string("M1") );
+  CMatrix::polynomials_t sym_polynomials = pe_matrix.getSymbolicPolynomials2(M1columns);
+
+  //setup the pre-elimination matrix in the code
+  code << M1type.str() << " M1(" << M1rows << "," << M1cols << ");" << std::endl;
+  code << "M1.fill(0.0);" << std::endl;
 
+  for( int r = 0; r < M1rows; r++ ) {
+    for( int c = 0; c < M1cols; c++ ) {
+      if( !pe_helper(r,c).isZero() )
+        code << "M1(" << r << "," << M1columns[c] << ") = " << pe_helper(r,c).getString(true) << "; ";
+    }
+    code << std::endl;
+  }
+  code << std::endl;
+  
+  if(useGaussJordan) {
+    code << "polyjam::gaussReduction(M1);" << std::endl << std::endl;
+  } else {
     //Add the actual elimination
     if( zp_polynomials.size() < M1rows ) {
       //this is the complicated case of over determination
 
       int M1rows2 = zp_polynomials.size();
       code << "//Use the pseudo-inverse to replace the Gauss-Jordan elimination (this here is the over determined case)" << std::endl;
-      code << "Eigen::Matrix<double," << M1rows2 << "," << M1cols << "> P = M1temp.block<" << M1rows << "," << M1rows2 << ">(0,0).transpose() * M1temp;" << std::endl;
+      code << "Eigen::Matrix<double," << M1rows2 << "," << M1cols << "> P = M1.block<" << M1rows << "," << M1rows2 << ">(0,0).transpose() * M1;" << std::endl;
       code << "Eigen::PartialPivLU< Eigen::Matrix<double," << M1rows2 << "," << M1rows2 << "> > lupre(P.block<" << M1rows2 << "," << M1rows2 << ">(0,0));" << std::endl;
-      code << "M1temp.block<" << M1rows2 << "," << (M1cols - M1rows2) << ">(0," << M1rows2 << ") = lupre.solve(P.block<" << M1rows2 << "," << (M1cols - M1rows2) << ">(0," << M1rows2 << "));" << std::endl;
-      code << "M1temp.block<" << M1rows2 << "," << M1rows2 << ">(0,0) = Eigen::MatrixXd::Identity(" << M1rows2 << "," << M1rows2 << ");" << std::endl;
-      code << "M1temp.block<" << (M1rows - M1rows2) << "," << M1cols << ">(" << M1rows2 << ",0) = Eigen::MatrixXd::Zero(" << (M1rows - M1rows2) << "," << M1cols << ");" << std::endl;
+      code << "M1.block<" << M1rows2 << "," << (M1cols - M1rows2) << ">(0," << M1rows2 << ") = lupre.solve(P.block<" << M1rows2 << "," << (M1cols - M1rows2) << ">(0," << M1rows2 << "));" << std::endl;
+      code << "M1.block<" << M1rows2 << "," << M1rows2 << ">(0,0) = Eigen::MatrixXd::Identity(" << M1rows2 << "," << M1rows2 << ");" << std::endl;
+      code << "M1.block<" << (M1rows - M1rows2) << "," << M1cols << ">(" << M1rows2 << ",0) = Eigen::MatrixXd::Zero(" << (M1rows - M1rows2) << "," << M1cols << ");" << std::endl;
       code << std::endl;
 
     } else {
 
-      //This here is the old version, which only works if the system is not over-determined
-      code << "Eigen::Matrix<double," << M1rows << "," << M1rows << "> temp = M1temp.topLeftCorner(" << M1rows << "," << M1rows << ").inverse();\n";
-      code << "Eigen::Matrix<double," << M1rows << "," << M1cols << "> temp2 = temp * M1temp;\n";
-      code << "M1temp = temp2;\n\n";
+      //This here is the regular case: factorize the leading block in place, and
+      //only solve for the remaining columns (the leading block becomes identity)
+      int M1rest = M1cols - M1rows;
+      code << "//Replace the Gauss-Jordan elimination by an in-place LU solve (this here is the regular case)" << std::endl;
+      code << "Eigen::Ref<Eigen::MatrixXd> M1lead = M1.leftCols(" << M1rows << ");" << std::endl;
+      code << "Eigen::PartialPivLU< Eigen::Ref<Eigen::MatrixXd> > lupre(M1lead);" << std::endl;
+      if( M1rest > 0 ) {
+        code << "M1.rightCols(" << M1rest << ") = lupre.permutationP() * M1.rightCols(" << M1rest << ");" << std::endl;
+        code << "lupre.matrixLU().triangularView<Eigen::UnitLower>().solveInPlace(M1.rightCols(" << M1rest << "));" << std::endl;
+        code << "lupre.matrixLU().triangularView<Eigen::Upper>().solveInPlace(M1.rightCols(" << M1rest << "));" << std::endl;
+      }
+      code << "M1.leftCols(" << M1rows << ").setIdentity();" << std::endl;
+      code << std::endl;
 
     }
-
-    //Now add the code for swapping back
-    code << "//Swap the columns back to the original form" << std::endl;
-    for( int i = 0; i < shufflingIndices.size(); i++ )
-      code << "M1.col(" << shufflingIndices[i] << ") = M1temp.col(" << i << ");" << std::endl;
-    code << std::endl;
   }
 
+  profiler.end();
   std::cout << "Pre-elimination is done." << std::endl;
 
-  //Now transform the vector of expanders and create the big matrix
-  CMatrix::eqs_t equations = transformExpanders( expanders, zp_polynomials.size() );
-  CMatrix big_matrix(zp_polynomials,equations);
-
-  //extract the don't miss Polys automatically
-  CMatrix attempt(zp_polynomials,equations);
-  attempt.reduce();
-  std::list<core::Poly*> goodPolynomials;
+  //The template (equations and monomials) only depends on the system, the expanders, the
+  //basis, the multiplier, and the layout of M1, so we can reuse the one of a previous run
+  std::stringstream templateKey;
+  templateKey << canonicalForm(symPolynomials) << "|expanders";
+  for( size_t i = 0; i < expanders.size(); i++ )
+    templateKey << " " << expanders[i].getString(false);
+  templateKey << "|basis";
   for( size_t i = 0; i < baseMonomials.size(); i++ )
+    templateKey << " " << baseMonomials[i].getString(false);
+  templateKey << "|multiplier " << multiplier.getString(false);
+  std::string templateFile = save_path + solverName + std::string(".template");
+
+  CMatrix::monomials_t finalMonomials;
+  CMatrix::eqs_t finalReorderedEquations;
+  profiler.begin("template");
+  if( loadTemplate( templateFile, templateKey.str(), M1columns, finalMonomials, finalReorderedEquations ) )
   {
-    core::Monomial multipliedBase = baseMonomials[i] * multiplier;
-    //check if we can find the multiplied base in the base
-    bool inBase = false;
-    for( size_t j = 0; j < baseMonomials.size(); j++ )
-    {
-      if( baseMonomials[j] == multipliedBase )
-      {
-        inBase = true;
-        break;
-      }
+    std::cout << "Reusing the template of a previous run (" << templateFile << ")." << std::endl;
+    profiler.record("cached",1);
+  }
+  else
+  {
+    //checkpoints of the template construction belong to this layout of M1 as well
+    std::stringstream checkpointKey;
+    checkpointKey << templateKey.str() << "|M1";
+    for( size_t i = 0; i < M1columns.size(); i++ )
+      checkpointKey << " " << M1columns[i];
+    std::string checkpointFile = save_path + solverName + std::string(".checkpoint");
+
+    buildTemplate( zp_polynomials, expanders, baseMonomials, multiplier, finalMonomials, finalReorderedEquations,
+        visualize, true, checkpointFile, checkpointKey.str(), options.checkpointInterval, &profiler );
+    saveTemplate( templateFile, templateKey.str(), M1columns, finalMonomials, finalReorderedEquations );
+  }
+  profiler.end();
+
+  //verify that the reordered matrix gives a good result
+  profiler.begin("verification");
+  CMatrix test_matrix( zp_polynomials, finalMonomials, finalReorderedEquations );
+  if(visualize)
+    test_matrix.visualize();
+  if(saveBeforeElimination)
+    test_matrix.save( std::string("M2before"), save_path );
+  test_matrix.reduce();
+  profiler.record("M2",test_matrix);
+  profiler.end();
+  if(visualize)
+    test_matrix.visualize();
+  if(saveAfterElimination)
+    test_matrix.save( std::string("M2after"), save_path );
+
+  if(savePolynomials) {
+    //use this block here in order to print the polynomials into a file
+    std::ofstream polynomialsFile;
+    polynomialsFile.open( (save_path + std::string("polynomials.txt")).c_str() );
+    polynomialsFile << "Printing all polynomials into the console" << std::endl;
+    CMatrix::polynomials_t printPolys = test_matrix.getPolynomials();
+    auto ititit = printPolys.begin();
+    while( ititit != printPolys.end() ) {
+      polynomialsFile << (*ititit)->getString(false);
+      ititit++;
     }
-    if( !inBase )
+    polynomialsFile << std::endl;
+    polynomialsFile.close();
+  }
+
+  if(saveMonomials) {
+    //use this block here to print all the monomials into a file
+    std::ofstream monomialsFile;
+    monomialsFile.open( (save_path + std::string("monomials.txt")).c_str() );
+    monomialsFile << "Printing all monomials into the console" << std::endl;
+    for( int i = 0; i < finalMonomials.size(); i++ )
     {
-      //ok, extract this polynomial
-      for( size_t j = 0; j < attempt.rows(); j++ )
-      {
-        core::Poly* tempPoly = new core::Poly(attempt.getPolynomial(j));
-        if( tempPoly->leadingTerm().monomial() == multipliedBase )
-        {
-          //we really need to find all of them here!
-          goodPolynomials.push_back(tempPoly);
-        }
-        else
-        {
-          delete tempPoly;
-        }
-      }
+      monomialsFile << finalMonomials[i].getString(false);
+      monomialsFile << std::endl;
     }
+    monomialsFile << std::endl;
+    monomialsFile.close();
   }
-
-  std::cout << "Extracted the polynomials that are needed for composing the Action matrix." << std::endl;
-  
-  //ok, now we have the big matrix (plus the monomials), the polynomials that should remain (goodPolynomials),
-  //plus a list of the origin of the equations
-  //the goal is now to continuously remove polynomials such that all original equations remain
-  std::list<int> usedEquations;
-  for( size_t i = 0; i < equations.size(); i++ )
-    usedEquations.push_back(i);
   
-  bool removedSome = true;
-  while(removedSome)
-  {
+  std::cout << "Extracting the code" << std::endl;
+  profiler.begin("emission");
+
+  //everything alright
+  //summary:
+  //we have the size of the elimination matrix from final_matrix
+  //we have the monomial order on top (finalMonomials)
+  //we have a list of the finalEquations, containing index of initial equation, plus monomial expander
+  //we have a list of the initial polynomials in symbolic form (sym_polynomials)
   
-  std::cout << "Trying to remove equations that are unnecessary." << std::endl;
-  int originalNumber = usedEquations.size();
-  std::list<int>::iterator ueIt = usedEquations.begin();
-  int ueInd = 0;
-  int toRemove = 1;
+  //now extract the code
   
-  while(ueIt != usedEquations.end())
-  {
-    std::cout << usedEquations.size() << " .. " << std::flush;
-    //std::cout << "Current size of expanders is " << usedEquations.size() << ". Original size was ";
-    //std::cout << originalNumber << ". Trying to remove " << toRemove << " expanders at index " << ueInd << "." << std::endl;
-  
-    //Remove a couple of Monomials
-    std::vector<int> removed;
-    for( int i = 0; i < toRemove; i++ )
-    {
-      removed.push_back(*ueIt);
-      ueIt = usedEquations.erase(ueIt);
-      if( ueIt == usedEquations.end() )
-        break;
-    }
-    
-    //std::cout << "Removed " << removed.size() << " expanders. Now computing the polynomials." << std::endl;
-    
-    //now check if all required polynomials are still around
-    //copy the corresponding rows, and perform gaussReduction
-    CMatrix subMatrix = big_matrix.subMatrix(usedEquations);
-    subMatrix.reduce();
-    
-    if( !subMatrix.contains(goodPolynomials) )
-    {
-      //std::cout << "I did not find all polynomials. This trial was unsuccessful." << std::endl;
-      //std::cout << "Readding the removed expanders." << std::endl;
-      
-      for( int i = removed.size()-1; i >= 0; i-- )
-        ueIt = usedEquations.insert(ueIt,removed[i]);
-      
-      if( removed.size() > 1 )
-        toRemove /= 2;
-      else
-      {
-        ueIt++; ueInd++;
-      }
-    }
-    else
-    {
-      //std::cout << "I found all polynomials. I am increasing the size of polynomials to remove." << std::endl;
-      toRemove *= 2;
-      while( toRemove > (int) usedEquations.size() )
-      {
-        //std::cout << "not possible, need to decrease less!" << std::endl;
-        toRemove /= 2;
-      }
-    }
-  }
-  
-  std::cout << std::endl;
-  std::cout << "I am done with this round. Original height of template was " << originalNumber << ". Now it is " << usedEquations.size() << "." << std::endl;
-  
-  if( true )//usedEquations.size() >= originalNumber )
-    removedSome = false;
-  
-  }
-  
-  //verify that the final matrix does not change in size anymore!
-  //in any case, this can be enforced (vanishing equations are simply redundant)
-  CMatrix subMatrix = big_matrix.subMatrix(usedEquations);
-  if(visualize)
-    subMatrix.visualize();
-  subMatrix.reduce();
-  if(visualize)
-    subMatrix.visualize();
-  
-  std::cout << "Removing unused monomials." << std::endl;
-
-  //ok, now we have to redo the computation such that we use only the final equations and monomials
-  std::vector<std::pair<int,core::Monomial> > finalEquations;
-  for( std::list<int>::iterator i = usedEquations.begin(); i != usedEquations.end(); i++ )
-    finalEquations.push_back(equations[*i]);
-  
-  CMatrix final_matrix(zp_polynomials,finalEquations);
-  if(visualize)
-    final_matrix.visualize();
-  final_matrix.reduce();
-  if(visualize)
-    final_matrix.visualize();
-
-  std::cout << "Final template size: " << final_matrix.rows() << "x" << final_matrix.cols() << std::endl;
-  
-  //once we are done with that, we should identify the leading monomials, and reorder the monomials
-  std::cout << "Reordering the monomials." << std::endl;
-  CMatrix::polynomials_t finalPolynomials = final_matrix.getPolynomials();
-  
-  CMatrix::monomials_t finalMonomials;
-  auto p = finalPolynomials.begin();
-  while( p != finalPolynomials.end() ) {
-    finalMonomials.push_back((**p).leadingTerm().monomial());
-    ++p;
-  }
-  CMatrix::monomials_t intMonomials = final_matrix.monomials();
-  for( size_t i = 0; i < intMonomials.size(); i++ ) {
-    core::Monomial temp = intMonomials[i];
-    bool found = false;
-    for( size_t j = 0; j < finalMonomials.size(); j++ ) {
-      if( temp == finalMonomials[j] ) {
-        found = true;
-        break;
-      }
-    }
-    if(!found)
-      finalMonomials.push_back(temp);
-  }
-
-  //New block: reorder the equations such that we are closest possible to row-echelon form
-  //finalEquations is of form: std::vector< std::pair<int,core::Monomial> >
-  //use test_matrix_temp to reorder the stuff
-  CMatrix test_matrix_temp( zp_polynomials, finalMonomials, finalEquations );
-  std::vector<int> preIndices; preIndices.reserve(test_matrix_temp.rows());
-  std::vector<int> postIndices; postIndices.reserve(test_matrix_temp.rows());
-  for( int i = 0; i < test_matrix_temp.rows(); i++ )
-    preIndices.push_back(i);
-  int currentCol = 0;
-  while( !preIndices.empty() ) {
-    std::vector<int>::iterator nonzeroSearcher = preIndices.begin();
-    while( nonzeroSearcher != preIndices.end() )
-    {
-      if( !test_matrix_temp(*nonzeroSearcher,currentCol).isZero() )
-      {
-        postIndices.push_back(*nonzeroSearcher);
-        nonzeroSearcher = preIndices.erase(nonzeroSearcher);
-      }
-      else
-        nonzeroSearcher++;
-    }
-    currentCol++;
-  }
-
-  std::vector<std::pair<int,core::Monomial> > finalReorderedEquations; finalReorderedEquations.reserve(finalEquations.size());
-  for( int i = 0; i < postIndices.size(); i++ )
-    finalReorderedEquations.push_back( finalEquations[postIndices[i]] );
-
-  //verify that the reordered matrix gives a good result
-  CMatrix test_matrix( zp_polynomials, finalMonomials, finalReorderedEquations );
-  if(visualize)
-    test_matrix.visualize();
-  if(saveBeforeElimination)
-    test_matrix.save( std::string("M2before"), save_path );
-  test_matrix.reduce();
-  if(visualize)
-    test_matrix.visualize();
-  if(saveAfterElimination)
-    test_matrix.save( std::string("M2after"), save_path );
-
-  if(savePolynomials) {
-    //use this block here in order to print the polynomials into a file
-    std::ofstream polynomialsFile;
-    polynomialsFile.open( (save_path + std::string("polynomials.txt")).c_str() );
-    polynomialsFile << "Printing all polynomials into the console" << std::endl;
-    CMatrix::polynomials_t printPolys = test_matrix.getPolynomials();
-    auto ititit = printPolys.begin();
-    while( ititit != printPolys.end() ) {
-      polynomialsFile << (*ititit)->getString(false);
-      ititit++;
-    }
-    polynomialsFile << std::endl;
-    polynomialsFile.close();
-  }
-
-  if(saveMonomials) {
-    //use this block here to print all the monomials into a file
-    std::ofstream monomialsFile;
-    monomialsFile.open( (save_path + std::string("monomials.txt")).c_str() );
-    monomialsFile << "Printing all monomials into the console" << std::endl;
-    for( int i = 0; i < finalMonomials.size(); i++ )
-    {
-      monomialsFile << finalMonomials[i].getString(false);
-      monomialsFile << std::endl;
-    }
-    monomialsFile << std::endl;
-    monomialsFile.close();
-  }
-  
-  std::cout << "Extracting the code" << std::endl;
-
-  //everything alright
-  //summary:
-  //we have the size of the elimination matrix from final_matrix
-  //we have the monomial order on top (finalMonomials)
-  //we have a list of the finalEquations, containing index of initial equation, plus monomial expander
-  //we have a list of the initial polynomials in symbolic form (sym_polynomials)
-  
-  //now extract the code
-  
-  int M2rows = final_matrix.rows();
-  int M2cols = final_matrix.cols();
+  int M2rows = finalReorderedEquations.size();
+  int M2cols = finalMonomials.size();
   int M3cols = M2cols - M2rows;
 
   std::stringstream M2type;
@@ -592,41 +823,48 @@ polyjam::generator::methods::generate(
   code << "M2.fill(0.0);" << std::endl;
   CMatrix helper(sym_polynomials,finalMonomials,finalReorderedEquations);
 
+  //collect all (destination,source) pairs as flat offsets into the column-major
+  //storage of M2 and M1, sorted by destination for sequential writes
+  std::vector< std::pair<int,int> > gatherOffsets;
   for( int r = 0; r < M2rows; r++ )
   {
-    code << "static const int ind_2_" << r << " [] = {";
-    bool insertComma = false;
-    for( int c = 0; c < M2cols; c++ )
-    {
-      if( !helper(r,c).isZero() )
-      {
-        if( insertComma )
-          code << ",";
-        code << c;
-        insertComma = true;
-      }
-    }
-    code << "};" << std::endl;
-
-    size_t numberCoefficients = 0;
-
-    code << "static const int ind_1_" << r << " [] = {";
-    insertComma = false;
+    int row1 = finalReorderedEquations[r].first;
     for( int c = 0; c < M2cols; c++ )
     {
       if( !helper(r,c).isZero() )
       {
-        if( insertComma )
-          code << ",";
         core::Coefficient temp = helper(r,c) - helper(r,c).one();
-        code << temp.getString();
-        insertComma = true;
-        numberCoefficients++;
+        int col1 = atoi(temp.getString().c_str());
+        gatherOffsets.push_back( std::pair<int,int>( c * M2rows + r, col1 * M1rows + row1 ) );
       }
     }
-    code << "};" << std::endl;
-    code << "initRow( M2, M1, " << r << ", " << finalReorderedEquations[r].first << ", ind_2_" << r << ", ind_1_" << r << ", " << numberCoefficients << "  );" << std::endl;
   }
+  std::sort( gatherOffsets.begin(), gatherOffsets.end() );
+
+  code << "static const int ind_2 [] = {";
+  for( size_t i = 0; i < gatherOffsets.size(); i++ )
+  {
+    if( i > 0 )
+      code << ",";
+    if( i % 20 == 0 )
+      code << std::endl << "    ";
+    code << gatherOffsets[i].first;
+  }
+  code << "};" << std::endl;
+  code << "static const int ind_1 [] = {";
+  for( size_t i = 0; i < gatherOffsets.size(); i++ )
+  {
+    if( i > 0 )
+      code << ",";
+    if( i % 20 == 0 )
+      code << std::endl << "    ";
+    code << gatherOffsets[i].second;
+  }
+  code << "};" << std::endl;
+  code << "double * M2data = M2.data();" << std::endl;
+  code << "const double * M1data = M1.data();" << std::endl;
+  code << "for( int i = 0; i < " << gatherOffsets.size() << "; i++ )" << std::endl;
+  code << "  M2data[ind_2[i]] = M1data[ind_1[i]];" << std::endl;
   code << std::endl;
   
   //add the matrix inversion and multiplication
@@ -643,31 +881,31 @@ polyjam::generator::methods::generate(
   Actiontype << "Eigen::Matrix<double," << solNbr << "," << solNbr << ">";
   code << Actiontype.str() << " Action = " << Actiontype.str() << "::Zero();" << std::endl;
   
+  //the ids of the base monomials are their indices, and products of the base with the
+  //multiplier that are not in the base get higher ids
+  core::MonomialTable bases;
+  for( int i = 0; i < solNbr; i++ )
+    bases.insert(baseMonomials[i]);
+  size_t multiplierId = bases.insert(multiplier);
+  core::MonomialTable columns;
+  for( size_t j = 0; j < finalMonomials.size(); j++ )
+    columns.insert(finalMonomials[j]);
+
+  std::vector<int> actionTargets(solNbr,-1);
   for( int i = 0; i < solNbr; i++ )
   {
-    core::Monomial temp = baseMonomials[i] * multiplier;
+    size_t product = bases.multiply(i,multiplierId);
     int index = -1;
-    for( int j = 0; j < solNbr; j++ )
-    {
-      if( baseMonomials[j] == temp )
-      {
-        index = j;
-        break;
-      }
-    }
-    if( index >= 0 )
+    if( product < (size_t) solNbr )
+      index = product;
+    if( index >= 0 ) {
       code << "Action(" << i << "," << index << ") = 1.0;" << std::endl;
+      actionTargets[i] = index;
+    }
     else
     {
       //get the values from the correct equation in M3
-      for( size_t j = 0; j < finalMonomials.size(); j++ )
-      {
-        if( temp == finalMonomials[j] )
-        {
-          index = j;
-          break;
-        }
-      }
+      index = columns.find(bases.monomial(product));
       
       code << "Action.row(" << i << ") -= M3.block(" << index << "," << (M3cols - solNbr) << ",1," << solNbr << ");" << std::endl;
     }
@@ -678,6 +916,46 @@ polyjam::generator::methods::generate(
   for( int i = 0; i < solNbr; i++ )
     code << " " << baseMonomials[i].getString(false);
   
+  //The trivial rows of Action link the base monomials into chains b, b*m, b*m^2, ..., where m is
+  //the multiplier. Only the last element of each chain has a non-trivial row. Given an eigenvalue l,
+  //the eigenvector therefore follows from the values at the chain starts, which are the null-vector
+  //of a reduced matrix with one row and column per chain.
+  std::vector<int> chainIndices(solNbr,-1);
+  std::vector<int> chainPowers(solNbr,0);
+  std::vector<int> chainEnds;
+  std::vector<bool> isTarget(solNbr,false);
+  for( int i = 0; i < solNbr; i++ ) {
+    if( actionTargets[i] >= 0 )
+      isTarget[actionTargets[i]] = true;
+  }
+  for( int i = 0; i < solNbr; i++ ) {
+    if( isTarget[i] )
+      continue;
+    int current = i;
+    int power = 0;
+    while( true ) {
+      chainIndices[current] = chainEnds.size();
+      chainPowers[current] = power;
+      if( actionTargets[current] < 0 )
+        break;
+      current = actionTargets[current];
+      power++;
+    }
+    chainEnds.push_back(current);
+  }
+  int chainNbr = chainEnds.size();
+  int maxPower = 0;
+  for( int i = 0; i < solNbr; i++ ) {
+    if( chainPowers[i] > maxPower )
+      maxPower = chainPowers[i];
+  }
+
+  if( exploitTrivialRows && chainNbr == solNbr ) {
+    std::cout << "Action has no trivial rows, using inverse iteration instead." << std::endl;
+    exploitTrivialRows = false;
+    realEigenvaluesOnly = true;
+  }
+
   //finally print the code to path
   std::ofstream file;
   file.open(codeFile.c_str());
@@ -871,37 +1149,109 @@ polyjam::generator::methods::generate(
     file << std::endl;
   }
   file << "void" << std::endl;
-  file << "polyjam::" << solverName << "::initRow(" << std::endl;
-  file << "    " << M2type.str() << " & M2," << std::endl;
-  file << "    const " << M1type.str() << " & M1," << std::endl;
-  file << "    int row2," << std::endl;
-  file << "    int row1," << std::endl;
-  file << "    const int * cols2," << std::endl;
-  file << "    const int * cols1," << std::endl;
-  file << "    size_t numberCols )" << std::endl;
-  file << "{" << std::endl;
-  file << "  for( int i = 0; i < numberCols; i++ )" << std::endl;
-  file << "    M2(row2,cols2[i]) = M1(row1,cols1[i]);" << std::endl;
-  file << "}" << std::endl;
-  file << std::endl;
-  file << "void" << std::endl;
   file << "polyjam::" << solverName << "::solve( " << parameters << ", " << solutionsType.str() << " & solutions )" << std::endl;
   file << "{" << std::endl;
   file << code.str() << std::endl;
   file << std::endl;
-  file << "  Eigen::EigenSolver< Eigen::Matrix<double," << solNbr << "," << solNbr << "> > Eig(Action,true);" << std::endl;
-  file << "  Eigen::Matrix<std::complex<double>," << solNbr << ",1> D = Eig.eigenvalues();" << std::endl;
-  file << "  Eigen::Matrix<std::complex<double>," << solNbr << "," << solNbr << "> V = Eig.eigenvectors();" << std::endl;
-  file << std::endl;
-  file << "  for( int c = 0; c < " << solNbr << "; c++ )" << std::endl;
-  file << "  {" << std::endl;
-  file << "    std::complex<double> eigValue = D[c];" << std::endl;
-  file << std::endl;
-  file << "    if( fabs(eigValue.imag()) < 0.0001 )" << std::endl;
-  file << "    {" << std::endl;
-  file << "      Eigen::Matrix<double," << unknownNbr << ",1> sol;" << std::endl;
-  file << std::endl;
-  file << "      std::complex<double> temp;" << std::endl;
+  if( realEigenvaluesOnly || exploitTrivialRows ) {
+    //eigenvalues only from the real Schur form, eigenvectors only for the real ones
+    if( exploitTrivialRows && chainNbr == 1 ) {
+      //a single chain is a companion matrix, which is already Hessenberg once the chain is reversed
+      file << "  static const int chain [] = {";
+      for( int r = 0; r < solNbr; r++ ) {
+        for( int i = 0; i < solNbr; i++ ) {
+          if( chainPowers[i] == solNbr - 1 - r ) {
+            if( r > 0 )
+              file << ",";
+            file << i;
+          }
+        }
+      }
+      file << "};" << std::endl;
+      file << "  " << Actiontype.str() << " H;" << std::endl;
+      file << "  for( int r = 0; r < " << solNbr << "; r++ )" << std::endl;
+      file << "  {" << std::endl;
+      file << "    for( int c = 0; c < " << solNbr << "; c++ )" << std::endl;
+      file << "      H(r,c) = Action(chain[r],chain[c]);" << std::endl;
+      file << "  }" << std::endl;
+      file << "  Eigen::RealSchur< " << Actiontype.str() << " > schur(" << solNbr << ");" << std::endl;
+      file << "  schur.computeFromHessenberg(H," << Actiontype.str() << "::Identity(),false);" << std::endl;
+    } else {
+      file << "  Eigen::RealSchur< " << Actiontype.str() << " > schur(Action,false);" << std::endl;
+    }
+    file << "  const " << Actiontype.str() << " & T = schur.matrixT();" << std::endl;
+    file << std::endl;
+    file << "  for( int c = 0; c < " << solNbr << "; c++ )" << std::endl;
+    file << "  {" << std::endl;
+    file << "    double eigValue = T(c,c);" << std::endl;
+    file << std::endl;
+    file << "    //2x2 blocks on the diagonal are complex conjugate pairs" << std::endl;
+    file << "    if( c < " << solNbr - 1 << " && T(c+1,c) != 0.0 )" << std::endl;
+    file << "    {" << std::endl;
+    file << "      double p = 0.5 * ( T(c,c) - T(c+1,c+1) );" << std::endl;
+    file << "      double disc = p * p + T(c,c+1) * T(c+1,c);" << std::endl;
+    file << "      eigValue = T(c+1,c+1) + p;" << std::endl;
+    file << "      c++;" << std::endl;
+    file << "      if( disc < 0.0 && sqrt(-disc) >= 0.0001 )" << std::endl;
+    file << "        continue;" << std::endl;
+    file << "    }" << std::endl;
+    file << std::endl;
+    if( exploitTrivialRows ) {
+      file << "    //recover the eigenvector from the chains of trivial rows" << std::endl;
+      file << "    double eigPowers[" << maxPower + 2 << "];" << std::endl;
+      file << "    eigPowers[0] = 1.0;" << std::endl;
+      file << "    for( int i = 1; i < " << maxPower + 2 << "; i++ )" << std::endl;
+      file << "      eigPowers[i] = eigPowers[i-1] * eigValue;" << std::endl;
+      if( chainNbr > 1 ) {
+        std::stringstream reducedType;
+        reducedType << "Eigen::Matrix<double," << chainNbr << "," << chainNbr << ">";
+        file << "    " << reducedType.str() << " P = " << reducedType.str() << "::Zero();" << std::endl;
+        for( int r = 0; r < chainNbr; r++ ) {
+          int end = chainEnds[r];
+          file << "    P(" << r << "," << r << ") = -eigPowers[" << chainPowers[end] + 1 << "];" << std::endl;
+          for( int j = 0; j < solNbr; j++ )
+            file << "    P(" << r << "," << chainIndices[j] << ") += Action(" << end << "," << j << ") * eigPowers[" << chainPowers[j] << "];" << std::endl;
+        }
+        file << "    Eigen::JacobiSVD< " << reducedType.str() << " > svd(P,Eigen::ComputeFullV);" << std::endl;
+        file << "    Eigen::Matrix<double," << chainNbr << ",1> starts = svd.matrixV().col(" << chainNbr - 1 << ");" << std::endl;
+      }
+      file << "    Eigen::Matrix<double," << solNbr << ",1> V;" << std::endl;
+      for( int i = 0; i < solNbr; i++ ) {
+        if( chainNbr > 1 )
+          file << "    V(" << i << ") = starts(" << chainIndices[i] << ") * eigPowers[" << chainPowers[i] << "];" << std::endl;
+        else
+          file << "    V(" << i << ") = eigPowers[" << chainPowers[i] << "];" << std::endl;
+      }
+    } else {
+      file << "    //recover the eigenvector by inverse iteration" << std::endl;
+      file << "    double shift = eigValue + 0.0000000001 * ( 1.0 + fabs(eigValue) );" << std::endl;
+      file << "    Eigen::PartialPivLU< " << Actiontype.str() << " > luInv( Action - shift * " << Actiontype.str() << "::Identity() );" << std::endl;
+      file << "    Eigen::Matrix<double," << solNbr << ",1> V = Eigen::Matrix<double," << solNbr << ",1>::Ones();" << std::endl;
+      file << "    for( int it = 0; it < 2; it++ )" << std::endl;
+      file << "    {" << std::endl;
+      file << "      V = luInv.solve(V);" << std::endl;
+      file << "      V.normalize();" << std::endl;
+      file << "    }" << std::endl;
+    }
+    file << std::endl;
+    file << "    {" << std::endl;
+    file << "      Eigen::Matrix<double," << unknownNbr << ",1> sol;" << std::endl;
+    file << std::endl;
+  } else {
+    file << "  Eigen::EigenSolver< Eigen::Matrix<double," << solNbr << "," << solNbr << "> > Eig(Action,true);" << std::endl;
+    file << "  Eigen::Matrix<std::complex<double>," << solNbr << ",1> D = Eig.eigenvalues();" << std::endl;
+    file << "  Eigen::Matrix<std::complex<double>," << solNbr << "," << solNbr << "> V = Eig.eigenvectors();" << std::endl;
+    file << std::endl;
+    file << "  for( int c = 0; c < " << solNbr << "; c++ )" << std::endl;
+    file << "  {" << std::endl;
+    file << "    std::complex<double> eigValue = D[c];" << std::endl;
+    file << std::endl;
+    file << "    if( fabs(eigValue.imag()) < 0.0001 )" << std::endl;
+    file << "    {" << std::endl;
+    file << "      Eigen::Matrix<double," << unknownNbr << ",1> sol;" << std::endl;
+    file << std::endl;
+    file << "      std::complex<double> temp;" << std::endl;
+  }
 
   for( int d = 0; d < unknownNbr; d++ )
   {
@@ -910,16 +1260,16 @@ polyjam::generator::methods::generate(
     exponents[d] = 1;
     core::Monomial unknown( exponents );
 
-    int b = -1;
-    for( b = 0; b < baseMonomials.size(); b++ )
-    {
-      if( unknown == baseMonomials[b] )
-        break;
-    }
-
-  file << "      temp = V(" << b << ",c) / V(" << solNbr - 1 << ",c);" << std::endl;
-  file << "      sol(" << d << "," << 0 << ") = temp.real();" << std::endl;
+    int b = bases.find(unknown);
+    if( b < 0 || b >= solNbr )
+      b = solNbr;
 
+    if( realEigenvaluesOnly || exploitTrivialRows ) {
+      file << "      sol(" << d << "," << 0 << ") = V(" << b << ") / V(" << solNbr - 1 << ");" << std::endl;
+    } else {
+      file << "      temp = V(" << b << ",c) / V(" << solNbr - 1 << ",c);" << std::endl;
+      file << "      sol(" << d << "," << 0 << ") = temp.real();" << std::endl;
+    }
   }
 
   file << "      solutions.push_back(sol);" << std::endl;
@@ -950,15 +1300,6 @@ polyjam::generator::methods::generate(
   header << "namespace " << solverName << std::endl;
   header << "{" << std::endl;
   header << std::endl;
-  header << "  void initRow(" << std::endl;
-  header << "      " << M2type.str() << " & M2," << std::endl;
-  header << "      const " << M1type.str() << " & M1," << std::endl;
-  header << "      int row2," << std::endl;
-  header << "      int row1," << std::endl;
-  header << "      const int * cols2," << std::endl;
-  header << "      const int * cols1," << std::endl;
-  header << "      size_t numberCols );" << std::endl;
-  header << std::endl;
   header << "  void solve( " << parameters << ", " << solutionsType.str() << " & solutions );" << std::endl;
   header << std::endl;
   header << "}" << std::endl;
@@ -966,6 +1307,810 @@ polyjam::generator::methods::generate(
   header << std::endl;
   header << "#endif /* POLYJAM_" << solverName << "_HPP_ */";
   header.close();
+
+  if( options.saveBenchmark )
+    generateBenchmark( pe_helper, save_path + solverName + std::string("_benchmark.cpp"), solverName, parameters, unknownNbr );
+  profiler.end();
+
+  if( options.profile ) {
+    profiler.saveJson( save_path + solverName + std::string(".profile.json") );
+    profiler.saveTrace( save_path + solverName + std::string(".trace.json") );
+  }
+}
+
+void
+polyjam::generator::methods::generateBenchmark(
+    CMatrix & symMatrix,
+    const std::string & benchmarkFile,
+    const std::string & solverName,
+    const std::string & parameters,
+    int unknowns )
+{
+  std::vector<std::string> types;
+  std::vector<std::string> names;
+  splitParameters( parameters, types, names );
+
+  std::stringstream arguments;
+  std::stringstream outputs;
+  for( size_t i = 0; i < names.size(); i++ ) {
+    if( i > 0 ) {
+      arguments << ", ";
+      outputs << ", ";
+    }
+    arguments << names[i];
+    outputs << types[i] << " & " << names[i];
+  }
+
+  //the original equations (rows of the matrix before the pre-elimination), term by term
+  int rows = symMatrix.rows();
+  int cols = symMatrix.cols();
+  CMatrix::monomials_t monomials = symMatrix.monomials();
+  std::stringstream equations;
+  for( int r = 0; r < rows; r++ ) {
+    for( int c = 0; c < cols; c++ ) {
+      if( symMatrix(r,c).isZero() )
+        continue;
+      equations << "  term = (" << symMatrix(r,c).getString(true) << ")";
+      if( !monomials[c].isOne() )
+        equations << " * " << monomials[c].getString(true);
+      equations << "; residual(" << r << ") += term; magnitude(" << r << ") += fabs(term);" << std::endl;
+    }
+  }
+
+  std::stringstream solutionType;
+  solutionType << "Eigen::Matrix<double," << unknowns << ",1>";
+  std::stringstream equationsType;
+  equationsType << "Eigen::Matrix<double," << rows << ",1>";
+
+  std::ofstream file(benchmarkFile.c_str());
+  if( !file.is_open() ) {
+    std::cout << "Error: could not write the benchmark " << benchmarkFile << std::endl;
+    return;
+  }
+
+  //the generated code is GPL as well, see the disclaimer in generate()
+  file << "/*************************************************************************" << std::endl;
+  file << " *                                                                       *" << std::endl;
+  file << " * polyjam, a polynomial solver generator for C++                        *" << std::endl;
+  file << " * Copyright (C) 2015 Laurent Kneip, The Australian National University  *" << std::endl;
+  file << " *                                                                       *" << std::endl;
+  file << " * This program is free software: you can redistribute it and/or modify  *" << std::endl;
+  file << " * it under the terms of the GNU General Public License as published by  *" << std::endl;
+  file << " * the Free Software Foundation, either version 3 of the License, or     *" << std::endl;
+  file << " * (at your option) any later version.                                   *" << std::endl;
+  file << " *                                                                       *" << std::endl;
+  file << " * This program is distributed in the hope that it will be useful,       *" << std::endl;
+  file << " * but WITHOUT ANY WARRANTY; without even the implied warranty of        *" << std::endl;
+  file << " * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *" << std::endl;
+  file << " * GNU General Public License for more details.                          *" << std::endl;
+  file << " *                                                                       *" << std::endl;
+  file << " * You should have received a copy of the GNU General Public License     *" << std::endl;
+  file << " * along with this program.  If not, see <http://www.gnu.org/licenses/>. *" << std::endl;
+  file << " *                                                                       *" << std::endl;
+  file << " *************************************************************************/" << std::endl;
+  file << std::endl;
+  file << "//This code is automatically generated by polyjam for benchmarking " << solverName << "." << std::endl;
+  file << "//It is licensed under the GNU GPL terms." << std::endl;
+  file << "//Please contact the author of polyjam for proprietary use." << std::endl;
+  file << "//" << std::endl;
+  file << "//usage: " << solverName << "_benchmark [instances] [seed]" << std::endl;
+  file << "//The instances are random coefficients by default. Compile with -DPOLYJAM_INSTANCE to" << std::endl;
+  file << "//sample them with sampleInstance( " << outputs.str() << " )" << std::endl;
+  file << "//from " << solverName << "_instance.hpp instead." << std::endl;
+  file << std::endl;
+  file << "#include <stdlib.h>" << std::endl;
+  file << "#include <stdio.h>" << std::endl;
+  file << "#include <iostream>" << std::endl;
+  file << "#include <vector>" << std::endl;
+  file << "#include <algorithm>" << std::endl;
+  file << "#include <chrono>" << std::endl;
+  file << "#include <random>" << std::endl;
+  file << "#include <new>" << std::endl;
+  file << "#include <cmath>" << std::endl;
+  file << std::endl;
+  file << "#include \"" << solverName << ".hpp\"" << std::endl;
+  file << std::endl;
+  file << std::endl;
+  file << "//count all heap allocations (Eigen calls malloc directly, so we count" << std::endl;
+  file << "//malloc where the C library allows it, and operator new otherwise)" << std::endl;
+  file << "static size_t allocations = 0;" << std::endl;
+  file << std::endl;
+  file << "#ifdef __GLIBC__" << std::endl;
+  file << "extern \"C\" void * __libc_malloc( size_t size );" << std::endl;
+  file << std::endl;
+  file << "extern \"C\" void * malloc( size_t size ) {" << std::endl;
+  file << "  allocations++;" << std::endl;
+  file << "  return __libc_malloc(size);" << std::endl;
+  file << "}" << std::endl;
+  file << "#else" << std::endl;
+  file << "void * operator new( size_t size ) {" << std::endl;
+  file << "  allocations++;" << std::endl;
+  file << "  void * pointer = malloc(size > 0 ? size : 1);" << std::endl;
+  file << "  if( pointer == NULL )" << std::endl;
+  file << "    throw std::bad_alloc();" << std::endl;
+  file << "  return pointer;" << std::endl;
+  file << "}" << std::endl;
+  file << std::endl;
+  file << "void operator delete( void * pointer ) noexcept {" << std::endl;
+  file << "  free(pointer);" << std::endl;
+  file << "}" << std::endl;
+  file << "#endif" << std::endl;
+  file << std::endl;
+  file << "namespace" << std::endl;
+  file << "{" << std::endl;
+  file << std::endl;
+  file << "std::mt19937 generator(1);" << std::endl;
+  file << std::endl;
+  file << "//uniform in [-1,1]" << std::endl;
+  file << "double uniform() {" << std::endl;
+  file << "  return std::uniform_real_distribution<double>(-1.0,1.0)(generator);" << std::endl;
+  file << "}" << std::endl;
+  file << std::endl;
+  file << "void sample( double & value ) {" << std::endl;
+  file << "  value = uniform();" << std::endl;
+  file << "}" << std::endl;
+  file << std::endl;
+  file << "template<typename DERIVED>" << std::endl;
+  file << "void sample( Eigen::MatrixBase<DERIVED> & matrix ) {" << std::endl;
+  file << "  for( int r = 0; r < matrix.rows(); r++ ) {" << std::endl;
+  file << "    for( int c = 0; c < matrix.cols(); c++ )" << std::endl;
+  file << "      matrix(r,c) = uniform();" << std::endl;
+  file << "  }" << std::endl;
+  file << "}" << std::endl;
+  file << std::endl;
+  file << "template<typename T, typename ALLOCATOR>" << std::endl;
+  file << "void sample( std::vector<T,ALLOCATOR> & vector ) {" << std::endl;
+  file << "  for( size_t i = 0; i < vector.size(); i++ )" << std::endl;
+  file << "    sample(vector[i]);" << std::endl;
+  file << "}" << std::endl;
+  file << std::endl;
+  file << "//the original equations, and the sum of the magnitudes of their terms" << std::endl;
+  file << "void residuals( " << parameters << ", const " << solutionType.str() << " & solution, ";
+  file << equationsType.str() << " & residual, " << equationsType.str() << " & magnitude ) {" << std::endl;
+  for( int i = 0; i < unknowns; i++ )
+    file << "  double x_" << (i+1) << " = solution(" << i << ",0);" << std::endl;
+  file << "  double term;" << std::endl;
+  file << "  residual.setZero();" << std::endl;
+  file << "  magnitude.setZero();" << std::endl;
+  file << equations.str();
+  file << "}" << std::endl;
+  file << std::endl;
+  file << "}" << std::endl;
+  file << std::endl;
+  file << "#ifdef POLYJAM_INSTANCE" << std::endl;
+  file << "#include \"" << solverName << "_instance.hpp\"" << std::endl;
+  file << "#else" << std::endl;
+  file << "void" << std::endl;
+  file << "sampleInstance( " << outputs.str() << " ) {" << std::endl;
+  for( size_t i = 0; i < names.size(); i++ ) {
+    if( types[i].find("std::vector") == 0 ) {
+      int maximum = maximumIndex( equations.str(), names[i] );
+      if( maximum >= 0 )
+        file << "  " << names[i] << ".resize(" << (maximum+1) << ");" << std::endl;
+    }
+    file << "  sample(" << names[i] << ");" << std::endl;
+  }
+  file << "}" << std::endl;
+  file << "#endif" << std::endl;
+  file << std::endl;
+  file << "int main( int argc, char** argv ) {" << std::endl;
+  file << "  size_t instances = 10000;" << std::endl;
+  file << "  if( argc > 1 )" << std::endl;
+  file << "    instances = atoi(argv[1]);" << std::endl;
+  file << "  if( argc > 2 )" << std::endl;
+  file << "    generator.seed(atoi(argv[2]));" << std::endl;
+  file << std::endl;
+  for( size_t i = 0; i < names.size(); i++ )
+    file << "  " << types[i] << " " << names[i] << ";" << std::endl;
+  file << "  std::vector< " << solutionType.str() << " > solutions;" << std::endl;
+  file << "  " << equationsType.str() << " residual, magnitude;" << std::endl;
+  file << std::endl;
+  file << "  std::vector<double> times;" << std::endl;
+  file << "  times.reserve(instances);" << std::endl;
+  file << "  size_t totalAllocations = 0;" << std::endl;
+  file << "  size_t totalSolutions = 0, minSolutions = 0, maxSolutions = 0;" << std::endl;
+  file << "  //bins of log10 of the relative residual: <-16, [-16,-15), ..., [-1,0), >=0" << std::endl;
+  file << "  std::vector<size_t> histogram(18,0);" << std::endl;
+  file << std::endl;
+  file << "  for( size_t i = 0; i < instances; i++ ) {" << std::endl;
+  file << "    sampleInstance( " << arguments.str() << " );" << std::endl;
+  file << "    solutions.clear();" << std::endl;
+  file << std::endl;
+  file << "    size_t allocationsBefore = allocations;" << std::endl;
+  file << "    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();" << std::endl;
+  file << "    polyjam::" << solverName << "::solve( " << arguments.str() << ", solutions );" << std::endl;
+  file << "    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();" << std::endl;
+  file << "    totalAllocations += allocations - allocationsBefore;" << std::endl;
+  file << "    times.push_back( std::chrono::duration<double,std::nano>(stop-start).count() );" << std::endl;
+  file << std::endl;
+  file << "    totalSolutions += solutions.size();" << std::endl;
+  file << "    if( i == 0 || solutions.size() < minSolutions )" << std::endl;
+  file << "      minSolutions = solutions.size();" << std::endl;
+  file << "    if( i == 0 || solutions.size() > maxSolutions )" << std::endl;
+  file << "      maxSolutions = solutions.size();" << std::endl;
+  file << std::endl;
+  file << "    for( size_t s = 0; s < solutions.size(); s++ ) {" << std::endl;
+  file << "      residuals( " << arguments.str() << ", solutions[s], residual, magnitude );" << std::endl;
+  file << "      double error = 0.0;" << std::endl;
+  file << "      for( int r = 0; r < residual.rows(); r++ )" << std::endl;
+  file << "        error = std::max( error, fabs(residual(r)) / std::max(magnitude(r),1e-300) );" << std::endl;
+  file << "      int bin = 0;" << std::endl;
+  file << "      if( error != error )" << std::endl;
+  file << "        bin = 17;" << std::endl;
+  file << "      else if( error > 0.0 )" << std::endl;
+  file << "        bin = std::max( 0, std::min( 17, (int) floor(log10(error)) + 17 ) );" << std::endl;
+  file << "      histogram[bin]++;" << std::endl;
+  file << "    }" << std::endl;
+  file << "  }" << std::endl;
+  file << std::endl;
+  file << "  if( instances == 0 )" << std::endl;
+  file << "    return 0;" << std::endl;
+  file << "  std::sort( times.begin(), times.end() );" << std::endl;
+  file << "  std::cout << \"" << solverName << ": \" << instances << \" instances\" << std::endl;" << std::endl;
+  file << "  std::cout << \"ns/call: min \" << times.front();" << std::endl;
+  file << "  std::cout << \", p50 \" << times[times.size()/2];" << std::endl;
+  file << "  std::cout << \", p90 \" << times[(times.size()*9)/10];" << std::endl;
+  file << "  std::cout << \", p99 \" << times[(times.size()*99)/100];" << std::endl;
+  file << "  std::cout << \", max \" << times.back() << std::endl;" << std::endl;
+  file << "  std::cout << \"allocations/call: \" << ((double) totalAllocations) / instances << std::endl;" << std::endl;
+  file << "  std::cout << \"real solutions/call: \" << ((double) totalSolutions) / instances;" << std::endl;
+  file << "  std::cout << \" (min \" << minSolutions << \", max \" << maxSolutions << \")\" << std::endl;" << std::endl;
+  file << "  std::cout << \"log10 relative residual:\" << std::endl;" << std::endl;
+  file << "  for( int b = 0; b < 18; b++ ) {" << std::endl;
+  file << "    if( b == 0 )" << std::endl;
+  file << "      std::cout << \"  < -16: \";" << std::endl;
+  file << "    else if( b == 17 )" << std::endl;
+  file << "      std::cout << \"  >= 0: \";" << std::endl;
+  file << "    else" << std::endl;
+  file << "      std::cout << \"  [\" << (b-17) << \",\" << (b-16) << \"): \";" << std::endl;
+  file << "    std::cout << histogram[b] << std::endl;" << std::endl;
+  file << "  }" << std::endl;
+  file << "  return 0;" << std::endl;
+  file << "}" << std::endl;
+  file.close();
+}
+
+std::string
+polyjam::generator::methods::canonicalForm( const std::list<core::Poly*> & polynomials )
+{
+  //the order of the equations does not matter
+  std::vector<std::string> equations;
+  std::list<core::Poly*>::const_iterator it = polynomials.begin();
+  while( it != polynomials.end() )
+  {
+    equations.push_back( (*it)->getString(false) );
+    it++;
+  }
+  std::sort( equations.begin(), equations.end() );
+
+  std::stringstream form;
+  form << "[" << polynomials.front()->leadingTerm().monomial().dimensions() << "]";
+  for( size_t i = 0; i < equations.size(); i++ )
+    form << "|" << equations[i];
+  return form.str();
+}
+
+std::string
+polyjam::generator::methods::hashString( const std::string & input )
+{
+  //64-bit FNV-1a, stable across platforms and compilers (unlike std::hash)
+  unsigned long long hash = 14695981039346656037ull;
+  for( size_t i = 0; i < input.size(); i++ )
+  {
+    hash ^= (unsigned char) input[i];
+    hash *= 1099511628211ull;
+  }
+
+  std::stringstream hex;
+  hex << std::hex;
+  hex.width(16);
+  hex.fill('0');
+  hex << hash;
+  return hex.str();
+}
+
+bool
+polyjam::generator::methods::loadTemplate(
+    const std::string & fileName,
+    const std::string & key,
+    const std::vector<int> & M1columns,
+    CMatrix::monomials_t & finalMonomials,
+    CMatrix::eqs_t & finalReorderedEquations )
+{
+  std::ifstream file(fileName.c_str());
+  if( !file.is_open() )
+    return false;
+
+  //make sure this is really the same system (and not a hash collision)
+  std::string line;
+  std::getline(file,line);
+  if( line != key )
+    return false;
+
+  //the layout of M1 needs to be the same, as the template refers to it
+  size_t numberColumns;
+  if( !(file >> numberColumns) || numberColumns != M1columns.size() )
+    return false;
+  for( size_t i = 0; i < numberColumns; i++ )
+  {
+    int column;
+    if( !(file >> column) || column != M1columns[i] )
+      return false;
+  }
+
+  size_t numberMonomials, numberEquations, nu;
+  if( !(file >> numberMonomials >> numberEquations >> nu) )
+    return false;
+
+  CMatrix::monomials_t monomials;
+  for( size_t i = 0; i < numberMonomials; i++ )
+  {
+    std::vector<unsigned int> exponents(nu,0);
+    for( size_t k = 0; k < nu; k++ )
+    {
+      if( !(file >> exponents[k]) )
+        return false;
+    }
+    monomials.push_back(core::Monomial(exponents));
+  }
+
+  CMatrix::eqs_t equations;
+  for( size_t i = 0; i < numberEquations; i++ )
+  {
+    int index;
+    std::vector<unsigned int> exponents(nu,0);
+    if( !(file >> index) )
+      return false;
+    for( size_t k = 0; k < nu; k++ )
+    {
+      if( !(file >> exponents[k]) )
+        return false;
+    }
+    equations.push_back( CMatrix::eq_t(index,core::Monomial(exponents)) );
+  }
+
+  finalMonomials = monomials;
+  finalReorderedEquations = equations;
+  return true;
+}
+
+void
+polyjam::generator::methods::saveTemplate(
+    const std::string & fileName,
+    const std::string & key,
+    const std::vector<int> & M1columns,
+    const CMatrix::monomials_t & finalMonomials,
+    const CMatrix::eqs_t & finalReorderedEquations )
+{
+  std::ofstream file(fileName.c_str());
+  if( !file.is_open() )
+  {
+    std::cout << "Error: could not write the template file " << fileName << std::endl;
+    return;
+  }
+
+  size_t nu = finalMonomials.front().dimensions();
+
+  file << key << std::endl;
+  file << M1columns.size();
+  for( size_t i = 0; i < M1columns.size(); i++ )
+    file << " " << M1columns[i];
+  file << std::endl;
+
+  file << finalMonomials.size() << " " << finalReorderedEquations.size() << " " << nu << std::endl;
+  for( size_t i = 0; i < finalMonomials.size(); i++ )
+  {
+    for( size_t k = 0; k < nu; k++ )
+      file << finalMonomials[i].exponents()[k] << " ";
+    file << std::endl;
+  }
+  for( size_t i = 0; i < finalReorderedEquations.size(); i++ )
+  {
+    file << finalReorderedEquations[i].first << " ";
+    for( size_t k = 0; k < nu; k++ )
+      file << finalReorderedEquations[i].second.exponents()[k] << " ";
+    file << std::endl;
+  }
+}
+
+bool
+polyjam::generator::methods::loadCheckpoint(
+    const std::string & fileName,
+    const std::string & key,
+    PruningState & state )
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  if( !file.is_open() )
+    return false;
+
+  //make sure this is really the same template construction
+  uint32_t keyLength;
+  if( !readBinary( file, keyLength ) || keyLength != key.size() )
+    return false;
+  std::string storedKey(keyLength,' ');
+  file.read( &storedKey[0], keyLength );
+  if( !file || storedKey != key )
+    return false;
+
+  //the random instance needs to be in the same field as ours
+  uint32_t characteristic, nu;
+  if( !readBinary( file, characteristic ) || !readBinary( file, nu ) )
+    return false;
+  if( characteristic != core::GenerationContext::current().characteristic() )
+    return false;
+
+  PruningState loaded;
+  uint32_t numberEquations, position;
+  int32_t toRemove, originalNumber;
+  bool valid =
+      readBinary( file, position ) &&
+      readBinary( file, toRemove ) &&
+      readBinary( file, originalNumber ) &&
+      readBinary( file, numberEquations );
+  for( uint32_t i = 0; valid && i < numberEquations; i++ ) {
+    uint32_t equation;
+    valid = readBinary( file, equation );
+    loaded.usedEquations.push_back(equation);
+  }
+  valid = valid &&
+      readPolynomials( file, nu, loaded.polynomials ) &&
+      readPolynomials( file, nu, loaded.goodPolynomials ) &&
+      position <= numberEquations;
+
+  if( !valid ) {
+    std::list<core::Poly*>::iterator it = loaded.polynomials.begin();
+    while( it != loaded.polynomials.end() )
+      delete *(it++);
+    it = loaded.goodPolynomials.begin();
+    while( it != loaded.goodPolynomials.end() )
+      delete *(it++);
+    return false;
+  }
+
+  loaded.position = position;
+  loaded.toRemove = toRemove;
+  loaded.originalNumber = originalNumber;
+  state = loaded;
+  return true;
+}
+
+void
+polyjam::generator::methods::saveCheckpoint(
+    const std::string & fileName,
+    const std::string & key,
+    const PruningState & state )
+{
+  //write to a temporary file first, such that an interruption never leaves a broken checkpoint
+  std::stringstream tempName;
+  tempName << fileName << "." << getpid();
+  std::ofstream file(tempName.str().c_str(), std::ios::binary);
+  if( !file.is_open() )
+  {
+    std::cout << "Error: could not write the checkpoint file " << fileName << std::endl;
+    return;
+  }
+
+  uint32_t nu = state.polynomials.front()->leadingTerm().monomial().dimensions();
+  writeBinary<uint32_t>( file, key.size() );
+  file.write( key.c_str(), key.size() );
+  writeBinary<uint32_t>( file, state.polynomials.front()->leadingTerm().coefficient().characteristic() );
+  writeBinary<uint32_t>( file, nu );
+
+  writeBinary<uint32_t>( file, state.position );
+  writeBinary<int32_t>( file, state.toRemove );
+  writeBinary<int32_t>( file, state.originalNumber );
+  writeBinary<uint32_t>( file, state.usedEquations.size() );
+  std::list<int>::const_iterator it = state.usedEquations.begin();
+  while( it != state.usedEquations.end() )
+    writeBinary<uint32_t>( file, *(it++) );
+
+  writePolynomials( file, state.polynomials );
+  writePolynomials( file, state.goodPolynomials );
+  file.close();
+
+  if( rename( tempName.str().c_str(), fileName.c_str() ) != 0 )
+    std::cout << "Error: could not write the checkpoint file " << fileName << std::endl;
+}
+
+void
+polyjam::generator::methods::buildTemplate(
+    const std::list<core::Poly*> & zp_polynomials,
+    const std::vector<core::Monomial> & expanders,
+    const std::vector<core::Monomial> & baseMonomials,
+    const core::Monomial & multiplier,
+    CMatrix::monomials_t & finalMonomials,
+    CMatrix::eqs_t & finalReorderedEquations,
+    bool visualize,
+    bool consolePrint,
+    const std::string & checkpointFile,
+    const std::string & checkpointKey,
+    int checkpointInterval,
+    Profiler * profiler )
+{
+  //the (many) temporary polynomials of the construction share one arena
+  core::Arena::Scope arena;
+
+  //continue from the checkpoint of an interrupted run if there is one (it brings
+  //its own random instance along, the resulting template is the same)
+  PruningState state;
+  bool resumed = !checkpointFile.empty() && loadCheckpoint( checkpointFile, checkpointKey, state );
+  if( resumed )
+    std::cout << "Resuming the template construction from " << checkpointFile << "." << std::endl;
+  else
+    state.polynomials = zp_polynomials;
+  const std::list<core::Poly*> & polynomials = state.polynomials;
+
+  //Now transform the vector of expanders and create the big matrix
+  if( profiler != NULL )
+    profiler->begin("expansion");
+  CMatrix::eqs_t equations = transformExpanders( expanders, polynomials.size() );
+  //all matrices of the template share the interned monomials and their products
+  core::MonomialTable monomials( polynomials.front()->leadingTerm().monomial().order() );
+  CMatrix big_matrix(polynomials,equations,&monomials);
+  if( profiler != NULL ) {
+    profiler->record("big matrix",big_matrix);
+    profiler->end();
+  }
+
+  std::list<core::Poly*> & goodPolynomials = state.goodPolynomials;
+  if( !resumed )
+  {
+    //extract the don't miss Polys automatically
+    if( profiler != NULL )
+      profiler->begin("extraction");
+    CMatrix attempt(polynomials,equations,&monomials);
+    attempt.reduce();
+    core::MonomialTable bases;
+    for( size_t i = 0; i < baseMonomials.size(); i++ )
+      bases.insert(baseMonomials[i]);
+    for( size_t i = 0; i < baseMonomials.size(); i++ )
+    {
+      core::Monomial multipliedBase = baseMonomials[i] * multiplier;
+      //check if we can find the multiplied base in the base
+      bool inBase = bases.find(multipliedBase) >= 0;
+      if( !inBase )
+      {
+        //ok, extract this polynomial
+        for( size_t j = 0; j < attempt.rows(); j++ )
+        {
+          core::Poly* tempPoly = new core::Poly(attempt.getPolynomial(j));
+          if( tempPoly->leadingTerm().monomial() == multipliedBase )
+          {
+            //we really need to find all of them here!
+            goodPolynomials.push_back(tempPoly);
+          }
+          else
+          {
+            delete tempPoly;
+          }
+        }
+      }
+    }
+
+    if( profiler != NULL ) {
+      profiler->record("reduced matrix",attempt);
+      profiler->record("good polynomials",goodPolynomials.size());
+      profiler->end();
+    }
+    if(consolePrint)
+      std::cout << "Extracted the polynomials that are needed for composing the Action matrix." << std::endl;
+
+    //ok, now we have the big matrix (plus the monomials), the polynomials that should remain (goodPolynomials),
+    //plus a list of the origin of the equations
+    //the goal is now to continuously remove polynomials such that all original equations remain
+    std::list<int> & usedEquations = state.usedEquations;
+    for( size_t i = 0; i < equations.size(); i++ )
+      usedEquations.push_back(i);
+    state.position = 0;
+    state.toRemove = 1;
+    state.originalNumber = usedEquations.size();
+  }
+  
+  bool removedSome = true;
+  while(removedSome)
+  {
+  
+  if(consolePrint)
+    std::cout << "Trying to remove equations that are unnecessary." << std::endl;
+  std::list<int> & usedEquations = state.usedEquations;
+  int originalNumber = state.originalNumber;
+  std::list<int>::iterator ueIt = usedEquations.begin();
+  std::advance( ueIt, state.position );
+  int ueInd = state.position;
+  int & toRemove = state.toRemove;
+  time_t lastCheckpoint = time(NULL);
+  size_t trials = 0;
+  size_t operations = 0;
+  if( profiler != NULL ) {
+    profiler->begin("pruning round");
+    profiler->record("rows before",usedEquations.size());
+  }
+  
+  while(ueIt != usedEquations.end())
+  {
+    //every trial has its own arena, such that its polynomials are released at once
+    core::Arena::Scope trialArena;
+
+    if(consolePrint)
+      std::cout << usedEquations.size() << " .. " << std::flush;
+
+    //save the state every once in a while, such that an interrupted run can continue from here
+    if( !checkpointFile.empty() && checkpointInterval > 0 && time(NULL) - lastCheckpoint >= checkpointInterval ) {
+      state.position = std::distance( usedEquations.begin(), ueIt );
+      saveCheckpoint( checkpointFile, checkpointKey, state );
+      lastCheckpoint = time(NULL);
+    }
+    //std::cout << "Current size of expanders is " << usedEquations.size() << ". Original size was ";
+    //std::cout << originalNumber << ". Trying to remove " << toRemove << " expanders at index " << ueInd << "." << std::endl;
+  
+    //Remove a couple of Monomials
+    std::vector<int> removed;
+    for( int i = 0; i < toRemove; i++ )
+    {
+      removed.push_back(*ueIt);
+      ueIt = usedEquations.erase(ueIt);
+      if( ueIt == usedEquations.end() )
+        break;
+    }
+    
+    //std::cout << "Removed " << removed.size() << " expanders. Now computing the polynomials." << std::endl;
+    
+    //now check if all required polynomials are still around
+    //copy the corresponding rows, and perform gaussReduction
+    CMatrix subMatrix = big_matrix.subMatrix(usedEquations);
+    subMatrix.reduce();
+    trials++;
+    operations += subMatrix.operations();
+    
+    if( !subMatrix.contains(goodPolynomials) )
+    {
+      //std::cout << "I did not find all polynomials. This trial was unsuccessful." << std::endl;
+      //std::cout << "Readding the removed expanders." << std::endl;
+      
+      for( int i = removed.size()-1; i >= 0; i-- )
+        ueIt = usedEquations.insert(ueIt,removed[i]);
+      
+      if( removed.size() > 1 )
+        toRemove /= 2;
+      else
+      {
+        ueIt++; ueInd++;
+      }
+    }
+    else
+    {
+      //std::cout << "I found all polynomials. I am increasing the size of polynomials to remove." << std::endl;
+      toRemove *= 2;
+      while( toRemove > (int) usedEquations.size() )
+      {
+        //std::cout << "not possible, need to decrease less!" << std::endl;
+        toRemove /= 2;
+      }
+    }
+  }
+  
+  if(consolePrint) {
+    std::cout << std::endl;
+    std::cout << "I am done with this round. Original height of template was " << originalNumber << ". Now it is " << usedEquations.size() << "." << std::endl;
+  }
+  
+  if( profiler != NULL ) {
+    profiler->record("rows after",usedEquations.size());
+    profiler->record("trials",trials);
+    profiler->record("operations",operations);
+    profiler->end();
+  }
+
+  if( true )//usedEquations.size() >= originalNumber )
+    removedSome = false;
+
+  //the next round starts over at the beginning
+  state.position = 0;
+  state.toRemove = 1;
+  state.originalNumber = usedEquations.size();
+  
+  }
+  
+  std::list<int> & usedEquations = state.usedEquations;
+  if( profiler != NULL )
+    profiler->begin("reordering");
+
+  //verify that the final matrix does not change in size anymore!
+  //in any case, this can be enforced (vanishing equations are simply redundant)
+  CMatrix subMatrix = big_matrix.subMatrix(usedEquations);
+  if(visualize)
+    subMatrix.visualize();
+  subMatrix.reduce();
+  if(visualize)
+    subMatrix.visualize();
+  
+  if(consolePrint)
+    std::cout << "Removing unused monomials." << std::endl;
+
+  //ok, now we have to redo the computation such that we use only the final equations and monomials
+  std::vector<std::pair<int,core::Monomial> > finalEquations;
+  for( std::list<int>::iterator i = usedEquations.begin(); i != usedEquations.end(); i++ )
+    finalEquations.push_back(equations[*i]);
+  
+  CMatrix final_matrix(polynomials,finalEquations,&monomials);
+  if(visualize)
+    final_matrix.visualize();
+  final_matrix.reduce();
+  if(visualize)
+    final_matrix.visualize();
+
+  if(consolePrint)
+    std::cout << "Final template size: " << final_matrix.rows() << "x" << final_matrix.cols() << std::endl;
+  
+  //once we are done with that, we should identify the leading monomials, and reorder the monomials
+  if(consolePrint)
+    std::cout << "Reordering the monomials." << std::endl;
+  CMatrix::polynomials_t finalPolynomials = final_matrix.getPolynomials();
+  
+  finalMonomials.clear();
+  auto p = finalPolynomials.begin();
+  while( p != finalPolynomials.end() ) {
+    finalMonomials.push_back((**p).leadingTerm().monomial());
+    ++p;
+  }
+  core::MonomialTable leading;
+  for( size_t i = 0; i < finalMonomials.size(); i++ )
+    leading.insert(finalMonomials[i]);
+  CMatrix::monomials_t intMonomials = final_matrix.monomials();
+  for( size_t i = 0; i < intMonomials.size(); i++ ) {
+    if( leading.find(intMonomials[i]) < 0 )
+      finalMonomials.push_back(intMonomials[i]);
+  }
+
+  //New block: reorder the equations such that we are closest possible to row-echelon form
+  //finalEquations is of form: std::vector< std::pair<int,core::Monomial> >
+  //use test_matrix_temp to reorder the stuff
+  CMatrix test_matrix_temp( polynomials, finalMonomials, finalEquations, &monomials );
+  std::vector<int> preIndices; preIndices.reserve(test_matrix_temp.rows());
+  std::vector<int> postIndices; postIndices.reserve(test_matrix_temp.rows());
+  for( int i = 0; i < test_matrix_temp.rows(); i++ )
+    preIndices.push_back(i);
+  int currentCol = 0;
+  while( !preIndices.empty() ) {
+    std::vector<int>::iterator nonzeroSearcher = preIndices.begin();
+    while( nonzeroSearcher != preIndices.end() )
+    {
+      if( !test_matrix_temp(*nonzeroSearcher,currentCol).isZero() )
+      {
+        postIndices.push_back(*nonzeroSearcher);
+        nonzeroSearcher = preIndices.erase(nonzeroSearcher);
+      }
+      else
+        nonzeroSearcher++;
+    }
+    currentCol++;
+  }
+
+  finalReorderedEquations.clear(); finalReorderedEquations.reserve(finalEquations.size());
+  for( int i = 0; i < postIndices.size(); i++ )
+    finalReorderedEquations.push_back( finalEquations[postIndices[i]] );
+
+  if( profiler != NULL ) {
+    profiler->record("final matrix",final_matrix);
+    profiler->end();
+  }
+
+  //the construction is complete, so the checkpoint is not needed anymore
+  if( !checkpointFile.empty() )
+    remove( checkpointFile.c_str() );
+
+  std::list<core::Poly*>::iterator polysIterator = goodPolynomials.begin();
+  while( polysIterator != goodPolynomials.end() ) {
+    delete (*polysIterator);
+    polysIterator++;
+  }
+  if( resumed ) {
+    polysIterator = state.polynomials.begin();
+    while( polysIterator != state.polynomials.end() ) {
+      delete (*polysIterator);
+      polysIterator++;
+    }
+  }
 }
 
 polyjam::generator::CMatrix::eqs_t
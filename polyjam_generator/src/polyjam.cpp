@@ -19,11 +19,14 @@
  *************************************************************************/
 
 #include <polyjam/polyjam.hpp>
-#include <sys/time.h>
 #include <cstdio>
 #include <memory>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <fstream>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
 
 
 void
@@ -35,10 +38,6 @@ polyjam::initGenerator()
   std::cout << "This program comes with ABSOLUTELY NO WARRANTY; It is free software:" << std::endl;
   std::cout << "you can redistribute it and/or modify it under the terms of the GNU General Public License" << std::endl;
   std::cout << std::endl;
-
-  struct timeval tic;
-  gettimeofday( &tic, 0 );
-  srand ( tic.tv_usec );
 }
 
 void
@@ -64,48 +63,120 @@ polyjam::execGenerator( list<Poly*> & eqs, list<Poly*> & eqs_sym, const string &
 void
 polyjam::execGenerator( list<Poly*> & eqs, list<Poly*> & eqs_sym, const string & solverName, const string & suffix, const string & parameters, bool visualize )
 {
-  std::cout << "Analysing the Groebner basis in Macaulay2 ..." << std::endl;
+  execGenerator( GenerationContext::current(), eqs, eqs_sym, solverName, suffix, parameters, visualize );
+}
 
-  //export the Zp equations to a Macaulay2 script
-  stringstream subdir;
-  subdir << WORKSPACEPATH << solverName << "/M2script";
+void
+polyjam::execGenerator( GenerationContext & context, list<Poly*> & eqs, list<Poly*> & eqs_sym, const string & solverName, const string & suffix, const string & parameters, bool visualize )
+{
+  GenerationContext::Scope scope(context);
 
-  struct stat info;
-  if( stat( subdir.str().c_str(), &info ) != 0 ) {
-    stringstream dircmd;
-    dircmd << "mkdir " << subdir.str();
-    system(dircmd.str().c_str());
-  }
+  int nu = (*eqs.begin())->leadingTerm().monomial().dimensions();
+  int dim = 0;
+  std::vector<Monomial> baseMonomials_temp;
 
-  stringstream tempfile;
-  if(suffix.empty()){
-    tempfile << subdir.str() << "/" << solverName << ".m2";
-  }
-  else{
-    tempfile << subdir.str() << "/" << solverName << "_" << suffix << ".m2";
-  }
-  ExportMacaulay exportMacaulay;
-  
+  Groebner groebner;
   std::list<Poly*>::const_iterator eqIter = eqs.begin();
   while( eqIter != eqs.end() )
   {
-    exportMacaulay.addPoly(**eqIter);
+    groebner.addPoly(**eqIter);
     ++eqIter;
   }
-  exportMacaulay.write(tempfile.str());
 
-  stringstream cmd;
-  cmd << MACAULAYCOMMAND << " --silent " << tempfile.str();
-  string macaulayOutput = exec(cmd.str().c_str());
+  //the key for the cache of the analysis results: the Zp coefficients are drawn
+  //randomly in each run, so we use the symbolic system if it is available
+  //(the random instance only serves as a generic representative of it)
+  string canonicalSystem;
+  if( eqs_sym.empty() )
+    canonicalSystem = groebner.canonicalForm();
+  else
+    canonicalSystem = methods::canonicalForm(eqs_sym);
 
-  std::cout << "The degree of the basis and the basis monomials (if existing) are:" << std::endl;
-  std::cout << macaulayOutput << std::endl;
+  stringstream cachedir;
+  cachedir << context.workspacePath() << "cache";
+  struct stat cacheinfo;
+  if( stat( cachedir.str().c_str(), &cacheinfo ) != 0 ) {
+    stringstream dircmd;
+    dircmd << "mkdir " << cachedir.str();
+    system(dircmd.str().c_str());
+  }
+  stringstream cachefile;
+  cachefile << cachedir.str() << "/" << methods::hashString(canonicalSystem) << ".ideal";
+
+  if( loadIdealAnalysis( cachefile.str(), canonicalSystem, dim, baseMonomials_temp ) )
+  {
+    std::cout << "Found the analysis of the ideal in the cache (" << cachefile.str() << ")." << std::endl;
+  }
+  else
+  {
+#ifdef USE_MACAULAY
+    std::cout << "Analysing the Groebner basis in Macaulay2 ..." << std::endl;
+
+    //export the Zp equations to a Macaulay2 script
+    stringstream subdir;
+    subdir << context.workspacePath() << solverName << "/M2script";
+
+    struct stat info;
+    if( stat( subdir.str().c_str(), &info ) != 0 ) {
+      stringstream dircmd;
+      dircmd << "mkdir " << subdir.str();
+      system(dircmd.str().c_str());
+    }
+
+    stringstream tempfile;
+    if(suffix.empty()){
+      tempfile << subdir.str() << "/" << solverName << ".m2";
+    }
+    else{
+      tempfile << subdir.str() << "/" << solverName << "_" << suffix << ".m2";
+    }
+    ExportMacaulay exportMacaulay;
+    
+    eqIter = eqs.begin();
+    while( eqIter != eqs.end() )
+    {
+      exportMacaulay.addPoly(**eqIter);
+      ++eqIter;
+    }
+    exportMacaulay.write(tempfile.str());
+
+    stringstream cmd;
+    cmd << MACAULAYCOMMAND << " --silent " << tempfile.str();
+    string macaulayOutput = exec(cmd.str().c_str());
+
+    std::cout << "The degree of the basis and the basis monomials (if existing) are:" << std::endl;
+    std::cout << macaulayOutput << std::endl;
+
+    //analyse the dimensionality
+    string line;
+    istringstream input_iss(macaulayOutput);
+    getline(input_iss, line);
+    dim = atoi(line.c_str());
+
+    //now extract the basis monomials from this string
+    if( dim == 0 )
+      extractMonomials(macaulayOutput,baseMonomials_temp,nu);
+#else
+    std::cout << "Analysing the Groebner basis ..." << std::endl;
+
+    if( !groebner.compute() )
+      return;
+
+    dim = groebner.dimension();
+    std::cout << "The dimension of the ideal is " << dim << "." << std::endl;
+    if( dim == 0 ) {
+      std::cout << "The degree of the basis and the basis monomials are:" << std::endl;
+      std::cout << groebner.degree() << std::endl;
+      for( size_t i = 0; i < groebner.standardMonomials().size(); i++ )
+        std::cout << groebner.standardMonomials()[i].getString(false) << " ";
+      std::cout << std::endl;
+      baseMonomials_temp = groebner.standardMonomials();
+    }
+#endif
+
+    saveIdealAnalysis( cachefile.str(), canonicalSystem, dim, baseMonomials_temp );
+  }
 
-  //analyse the dimensionality
-  string line;
-  istringstream input_iss(macaulayOutput);
-  getline(input_iss, line);
-  int dim = atoi(line.c_str());
   if( dim != 0 )
   {
     if( dim > 0 )
@@ -117,24 +188,19 @@ polyjam::execGenerator( list<Poly*> & eqs, list<Poly*> & eqs_sym, const string &
     return;
   }
 
-  //now extract the basis monomials from this string
-  std::vector<Monomial> baseMonomials_temp;
-  int nu = (*eqs.begin())->leadingTerm().monomial().dimensions();
-  extractMonomials(macaulayOutput,baseMonomials_temp,nu);
-
   //now sort the base monomials
   std::vector<Monomial> baseMonomials;
   Poly orderingPolynomial = Poly::zeroZ(nu);
   Poly c1 = Poly::oneZ(nu);
   for( size_t i = 0; i < baseMonomials_temp.size(); i++ )
-    orderingPolynomial += Term( c1.leadingTerm().coefficient().clone(), baseMonomials_temp[i] );
+    orderingPolynomial += Term( c1.leadingTerm().coefficient(), baseMonomials_temp[i] );
   Poly::terms_t::iterator it2 = orderingPolynomial.begin();
   while( it2 != orderingPolynomial.end() ) {
     baseMonomials.push_back( it2->monomial() );
     it2++;
   }
 
-  execGeneratorInternal(false,eqs,eqs_sym,-1,baseMonomials,solverName,suffix,parameters,visualize);
+  execGeneratorInternal(context,false,eqs,eqs_sym,-1,baseMonomials,solverName,suffix,parameters,visualize);
 }
 
 void
@@ -157,13 +223,19 @@ polyjam::execGeneratorSym( list<Poly*> & eqs, list<Poly*> & eqs_sym, int expande
 
 void
 polyjam::execGeneratorSym( list<Poly*> & eqs, list<Poly*> & eqs_sym, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & suffix, const string & parameters, bool visualize ) {
-  execGeneratorInternal(true,eqs,eqs_sym,expanderDegree,baseMonomials,solverName,suffix,parameters,visualize);
+  execGeneratorSym( GenerationContext::current(), eqs, eqs_sym, expanderDegree, baseMonomials, solverName, suffix, parameters, visualize );
+}
+
+void
+polyjam::execGeneratorSym( GenerationContext & context, list<Poly*> & eqs, list<Poly*> & eqs_sym, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & suffix, const string & parameters, bool visualize ) {
+  GenerationContext::Scope scope(context);
+  execGeneratorInternal(context,true,eqs,eqs_sym,expanderDegree,baseMonomials,solverName,suffix,parameters,visualize);
 }
 
 
 
 void
-polyjam::execGeneratorInternal( bool even, list<Poly*> & eqs, list<Poly*> & eqs_sym, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & suffix, const string & parameters, bool visualize )
+polyjam::execGeneratorInternal( GenerationContext & context, bool even, list<Poly*> & eqs, list<Poly*> & eqs_sym, int expanderDegree, std::vector<Monomial> & baseMonomials, const string & solverName, const string & suffix, const string & parameters, bool visualize )
 {
   //create a list of monomials for all the unknowns (those will expand the original system of equations)
   vector<Monomial> expanders;
@@ -192,9 +264,15 @@ polyjam::execGeneratorInternal( bool even, list<Poly*> & eqs, list<Poly*> & eqs_
   } else {
     //if expanderDegree is less than 0, it means that we have to find it automatically
     if( expanderDegree < 0 ) {
-      std::cout << "Finding the degree of expansion." << std::endl;
-      expanderDegree = methods::automaticDegreeFinder(
-          eqs, expanders, baseMonomials, multiplier, visualize, true );
+      if( context.options().searchActionVariable ) {
+        std::cout << "Searching the action variable and the degree of expansion." << std::endl;
+        if( !methods::searchTemplate( eqs, expanders, baseMonomials, context.options().maxSearchDegree, multiplier, expanderDegree ) )
+          return;
+      } else {
+        std::cout << "Finding the degree of expansion." << std::endl;
+        expanderDegree = methods::automaticDegreeFinder(
+            eqs, expanders, baseMonomials, multiplier, visualize, true );
+      }
     }
     methods::generateSuperlinearExpanders(expanders,expanderDegree);
   }
@@ -202,9 +280,9 @@ polyjam::execGeneratorInternal( bool even, list<Poly*> & eqs, list<Poly*> & eqs_
   //generate sub-directory if it does not exist
   stringstream subdir2;
   if(suffix.empty()) {
-    subdir2 << SOLVERPATH << solverName;
+    subdir2 << context.solverPath() << solverName;
   }else{
-    subdir2 << SOLVERPATH << solverName << "_" << suffix;
+    subdir2 << context.solverPath() << solverName << "_" << suffix;
   }
 
   struct stat info2;
@@ -217,27 +295,143 @@ polyjam::execGeneratorInternal( bool even, list<Poly*> & eqs, list<Poly*> & eqs_
   std::cout << "Starting the solver generation." << std::endl;
   stringstream codeFile;
   if(suffix.empty()){
-    codeFile << SOLVERPATH << solverName << "/" << solverName << ".cpp";
+    codeFile << context.solverPath() << solverName << "/" << solverName << ".cpp";
   } else {
-    codeFile << SOLVERPATH << solverName << "/" << solverName << "_" << suffix << ".cpp";
+    codeFile << context.solverPath() << solverName << "/" << solverName << "_" << suffix << ".cpp";
   }
   stringstream headerFile;
   if(suffix.empty()){
-    headerFile << SOLVERPATH << solverName << "/" << solverName << ".hpp";
+    headerFile << context.solverPath() << solverName << "/" << solverName << ".hpp";
   } else {
-    headerFile << SOLVERPATH << solverName << "/" << solverName << "_" << suffix << ".hpp";
+    headerFile << context.solverPath() << solverName << "/" << solverName << "_" << suffix << ".hpp";
   }
 
   stringstream savePathSS;
-  savePathSS << SOLVERPATH << solverName << "/";
+  savePathSS << context.solverPath() << solverName << "/";
 
   if(suffix.empty()){
-    methods::generate( eqs, eqs_sym, expanders, baseMonomials, multiplier, headerFile.str(), codeFile.str(), (solverName), parameters, savePathSS.str(), visualize);
+    methods::generate( eqs, eqs_sym, expanders, baseMonomials, multiplier, headerFile.str(), codeFile.str(), (solverName), parameters, savePathSS.str(), context, visualize);
   } else {
-    methods::generate( eqs, eqs_sym, expanders, baseMonomials, multiplier, headerFile.str(), codeFile.str(), (solverName + "_" + suffix), parameters, savePathSS.str(), visualize );
+    methods::generate( eqs, eqs_sym, expanders, baseMonomials, multiplier, headerFile.str(), codeFile.str(), (solverName + "_" + suffix), parameters, savePathSS.str(), context, visualize );
   }
 }
 
+polyjam::GenerationJob::GenerationJob() :
+    expanderDegree(-1)
+{}
+
+int
+polyjam::execBatch( const vector<GenerationJob> & jobs, GenerationContext & context, int numberWorkers )
+{
+  if( numberWorkers <= 0 )
+    numberWorkers = sysconf(_SC_NPROCESSORS_ONLN);
+  if( numberWorkers <= 0 )
+    numberWorkers = 1;
+
+  //the logs of the individual jobs
+  stringstream logdir;
+  logdir << context.workspacePath() << "logs";
+  struct stat loginfo;
+  if( stat( logdir.str().c_str(), &loginfo ) != 0 ) {
+    stringstream dircmd;
+    dircmd << "mkdir " << logdir.str();
+    system(dircmd.str().c_str());
+  }
+
+  //the children inherit the buffers, so empty them before forking
+  std::cout.flush();
+  fflush(stdout);
+
+  //every job runs in a process of its own, at most numberWorkers at a time
+  vector<pid_t> processes(jobs.size(),-1);
+  vector<string> names(jobs.size());
+  vector<string> logs(jobs.size());
+  size_t nextJob = 0;
+  int running = 0;
+  int failed = 0;
+
+  while( nextJob < jobs.size() || running > 0 )
+  {
+    while( nextJob < jobs.size() && running < numberWorkers )
+    {
+      const GenerationJob & job = jobs[nextJob];
+      string & fullName = names[nextJob];
+      fullName = job.solverName;
+      if( !job.suffix.empty() )
+        fullName += "_" + job.suffix;
+      logs[nextJob] = logdir.str() + "/" + fullName + ".log";
+
+      pid_t pid = fork();
+      if( pid < 0 )
+      {
+        std::cout << "Error: could not start the job " << fullName << std::endl;
+        failed++;
+        nextJob++;
+        continue;
+      }
+
+      if( pid == 0 )
+      {
+        //child: redirect the console output into the log of this job
+        int log = open( logs[nextJob].c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+        if( log >= 0 )
+        {
+          dup2(log,STDOUT_FILENO);
+          dup2(log,STDERR_FILENO);
+          close(log);
+        }
+
+        //each job gets its own random numbers, but the same paths and options
+        GenerationContext jobContext(context);
+        jobContext.seed( context.generator()() + nextJob );
+        GenerationContext::Scope scope(jobContext);
+
+        list<Poly*> eqs, eqs_zp, eqs_sym;
+        job.equations(jobContext,eqs);
+        splitPolyLists(eqs, eqs_zp, eqs_sym);
+        if( job.baseMonomials.empty() )
+          execGenerator( jobContext, eqs_zp, eqs_sym, job.solverName, job.suffix, job.parameters, false );
+        else
+        {
+          vector<Monomial> baseMonomials = job.baseMonomials;
+          execGeneratorSym( jobContext, eqs_zp, eqs_sym, job.expanderDegree, baseMonomials, job.solverName, job.suffix, job.parameters, false );
+        }
+
+        std::cout.flush();
+        fflush(stdout);
+        _exit(0);
+      }
+
+      std::cout << "Started " << fullName << " (log: " << logs[nextJob] << ")" << std::endl;
+      processes[nextJob] = pid;
+      running++;
+      nextJob++;
+    }
+
+    //wait for any of the jobs to finish
+    int status;
+    pid_t pid = wait(&status);
+    if( pid < 0 )
+      break;
+    for( size_t i = 0; i < processes.size(); i++ )
+    {
+      if( processes[i] != pid )
+        continue;
+      running--;
+      processes[i] = -1;
+      if( WIFEXITED(status) && WEXITSTATUS(status) == 0 )
+        std::cout << "Finished " << names[i] << std::endl;
+      else
+      {
+        std::cout << "Error: the job " << names[i] << " failed, see " << logs[i] << std::endl;
+        failed++;
+      }
+    }
+  }
+
+  return failed;
+}
+
 void
 polyjam::splitPolyLists( list<Poly*> & eqs, list<Poly*> & eqs_zp, list<Poly*> & eqs_sym ) {
   list<Poly*>::iterator it = eqs.begin();
@@ -255,6 +449,73 @@ polyjam::splitPolyLists( list<Poly*> & eqs, list<Poly*> & eqs_zp, list<Poly*> &
   }
 }
 
+bool
+polyjam::loadIdealAnalysis( const string & fileName, const string & canonicalSystem, int & dim, vector<Monomial> & baseMonomials )
+{
+  ifstream file(fileName.c_str());
+  if( !file.is_open() )
+    return false;
+
+  //make sure this is really the same system (and not a hash collision)
+  string line;
+  getline(file,line);
+  if( line != canonicalSystem )
+    return false;
+
+  int cachedDim;
+  size_t numberMonomials, nu;
+  if( !(file >> cachedDim >> numberMonomials >> nu) )
+    return false;
+
+  vector<Monomial> monomials;
+  for( size_t i = 0; i < numberMonomials; i++ )
+  {
+    vector<unsigned int> exponents(nu,0);
+    for( size_t k = 0; k < nu; k++ )
+    {
+      if( !(file >> exponents[k]) )
+        return false;
+    }
+    monomials.push_back(Monomial(exponents));
+  }
+
+  dim = cachedDim;
+  baseMonomials = monomials;
+  return true;
+}
+
+void
+polyjam::saveIdealAnalysis( const string & fileName, const string & canonicalSystem, int dim, const vector<Monomial> & baseMonomials )
+{
+  //the cache is shared between concurrent generations, so write to a
+  //temporary file first and move it into place at once
+  stringstream tempName;
+  tempName << fileName << "." << getpid();
+  ofstream file(tempName.str().c_str());
+  if( !file.is_open() )
+  {
+    std::cout << "Error: could not write the cache file " << fileName << std::endl;
+    return;
+  }
+
+  size_t nu = 0;
+  if( !baseMonomials.empty() )
+    nu = baseMonomials.front().dimensions();
+
+  file << canonicalSystem << std::endl;
+  file << dim << " " << baseMonomials.size() << " " << nu << std::endl;
+  for( size_t i = 0; i < baseMonomials.size(); i++ )
+  {
+    for( size_t k = 0; k < nu; k++ )
+      file << baseMonomials[i].exponents()[k] << " ";
+    file << std::endl;
+  }
+  file.close();
+
+  if( rename( tempName.str().c_str(), fileName.c_str() ) != 0 )
+    std::cout << "Error: could not write the cache file " << fileName << std::endl;
+}
+
 string
 polyjam::exec( const char * cmd )
 {
@@ -0,0 +1,76 @@
+//Random instances of the generalized P3P problem for gen3pt_benchmark.cpp
+//(same construction as test.cpp: a random camera system observing three points)
+
+namespace
+{
+
+Eigen::Matrix3d
+cayley2rot( const Eigen::Vector3d & cayley )
+{
+  Eigen::Matrix3d R;
+  double scale = 1+pow(cayley[0],2)+pow(cayley[1],2)+pow(cayley[2],2);
+
+  R(0,0) = 1+pow(cayley[0],2)-pow(cayley[1],2)-pow(cayley[2],2);
+  R(0,1) = 2*(cayley[0]*cayley[1]-cayley[2]);
+  R(0,2) = 2*(cayley[0]*cayley[2]+cayley[1]);
+  R(1,0) = 2*(cayley[0]*cayley[1]+cayley[2]);
+  R(1,1) = 1-pow(cayley[0],2)+pow(cayley[1],2)-pow(cayley[2],2);
+  R(1,2) = 2*(cayley[1]*cayley[2]-cayley[0]);
+  R(2,0) = 2*(cayley[0]*cayley[2]-cayley[1]);
+  R(2,1) = 2*(cayley[1]*cayley[2]+cayley[0]);
+  R(2,2) = 1-pow(cayley[0],2)-pow(cayley[1],2)+pow(cayley[2],2);
+
+  R = (1/scale) * R;
+  return R;
+}
+
+}
+
+void
+sampleInstance( std::vector<Eigen::Vector3d> & fs, std::vector<Eigen::Vector3d> & vs, std::vector<Eigen::Vector3d> & wps )
+{
+  int numberCameras = 4;
+
+  //generate random translation and rotation
+  Eigen::Vector3d translation;
+  for( int i = 0; i < 3; i++ )
+    translation[i] = uniform()*2.0;
+
+  Eigen::Vector3d cay;
+  for( int i = 0; i < 3; i++ )
+    cay[i] = uniform()*0.5;
+  Eigen::Matrix3d R = cayley2rot(cay);
+
+  //create a random camera-system
+  std::vector<Eigen::Vector3d> camOffsets;
+  std::vector<Eigen::Matrix3d> camRotations;
+  for( int i = 0; i < numberCameras; i++ ) {
+    Eigen::Vector3d c1, c2;
+    for( int j = 0; j < 3; j++ ) {
+      c1[j] = uniform();
+      c2[j] = uniform();
+    }
+    camOffsets.push_back(cayley2rot(c1).col(0)*0.5);
+    camRotations.push_back(cayley2rot(c2));
+  }
+
+  //three random points, their bearing vectors in the viewpoint frame, and the camera offsets
+  fs.resize(3);
+  vs.resize(3);
+  wps.resize(3);
+  for( int i = 0; i < 3; i++ ) {
+    Eigen::Vector3d cleanPoint;
+    for( int j = 0; j < 3; j++ )
+      cleanPoint[j] = uniform();
+    Eigen::Vector3d direction = cleanPoint / cleanPoint.norm();
+    wps[i] = (8.0-4.0) * cleanPoint + 4.0 * direction;
+
+    int camCorrespondence = i % numberCameras;
+    Eigen::Vector3d bodyPoint = R.transpose()*(wps[i] - translation);
+    Eigen::Vector3d bearingVector = camRotations[camCorrespondence].transpose()*(bodyPoint - camOffsets[camCorrespondence]);
+    bearingVector = bearingVector / bearingVector.norm();
+
+    fs[i] = camRotations[camCorrespondence] * bearingVector;
+    vs[i] = camOffsets[camCorrespondence];
+  }
+}
@@ -0,0 +1,86 @@
+//Random instances of the PnP problem for opnp_benchmark.cpp
+//(same construction as test.cpp: a random scaled rotation observing three points)
+
+void
+sampleInstance(
+    std::vector<Eigen::Vector3d> & fs, std::vector<Eigen::Vector3d> & wps,
+    Eigen::Vector3d & f_center, Eigen::Vector3d & wp_center,
+    std::vector<Eigen::Vector3d> & uwps, std::vector<Eigen::Vector3d> & vwps,
+    Eigen::Vector3d & uwp_center, Eigen::Vector3d & vwp_center )
+{
+  size_t numberBearingVectors = 3;
+
+  //first create a normalized quaternion
+  Eigen::Matrix<double,4,1> q_gt;
+  for( int i = 0; i < 4; i++ )
+    q_gt[i] = uniform();
+  q_gt /= q_gt.norm();
+
+  //Then sample random depths and get average depth
+  std::vector<double> depths;
+  double averageDepth = 0.0;
+  for( size_t i = 0; i < numberBearingVectors; i++ ) {
+    depths.push_back( (uniform()+1.0)*0.5 );
+    averageDepth += depths.back();
+  }
+  averageDepth /= (double) numberBearingVectors;
+
+  //now resample the quaternion to make sure it is what we want
+  q_gt *= sqrt(averageDepth);
+
+  //derive the scaled rotation matrix
+  Eigen::Matrix3d R_gt;
+  R_gt(0,0) = (q_gt[0]*q_gt[0]) + (q_gt[1]*q_gt[1]) - (q_gt[2]*q_gt[2]) - (q_gt[3]*q_gt[3]);
+  R_gt(1,1) = (q_gt[0]*q_gt[0]) - (q_gt[1]*q_gt[1]) + (q_gt[2]*q_gt[2]) - (q_gt[3]*q_gt[3]);
+  R_gt(2,2) = (q_gt[0]*q_gt[0]) - (q_gt[1]*q_gt[1]) - (q_gt[2]*q_gt[2]) + (q_gt[3]*q_gt[3]);
+  R_gt(0,1) = 2.0 * (q_gt[1]*q_gt[2]-q_gt[3]*q_gt[0]);
+  R_gt(0,2) = 2.0 * (q_gt[1]*q_gt[3]+q_gt[2]*q_gt[0]);
+  R_gt(1,2) = 2.0 * (q_gt[2]*q_gt[3]-q_gt[1]*q_gt[0]);
+  R_gt(1,0) = 2.0 * (q_gt[1]*q_gt[2]+q_gt[3]*q_gt[0]);
+  R_gt(2,0) = 2.0 * (q_gt[1]*q_gt[3]-q_gt[2]*q_gt[0]);
+  R_gt(2,1) = 2.0 * (q_gt[2]*q_gt[3]+q_gt[1]*q_gt[0]);
+
+  //random translation (this is not the true translation, but a scale one again)
+  Eigen::Vector3d t_gt;
+  for( int i = 0; i < 3; i++ )
+    t_gt[i] = uniform() / averageDepth;
+
+  //random image measurements
+  fs.resize(numberBearingVectors);
+  for( size_t i = 0; i < numberBearingVectors; i++ ) {
+    fs[i][0] = uniform();
+    fs[i][1] = uniform();
+    fs[i][2] = 1.0;
+  }
+
+  //derive the world points
+  wps.resize(numberBearingVectors);
+  for( size_t i = 0; i < numberBearingVectors; i++ ) {
+    double scaledDepth = depths[i] / averageDepth;
+    wps[i] = R_gt.inverse() * ( fs[i] * scaledDepth - t_gt);
+  }
+
+  //center of image points
+  f_center = Eigen::Vector3d::Zero();
+  for( size_t i = 0; i < numberBearingVectors; i++ )
+    f_center += fs[i];
+  f_center /= (double) numberBearingVectors;
+
+  //center of the world points
+  wp_center = Eigen::Vector3d::Zero();
+  for( size_t i = 0; i < numberBearingVectors; i++ )
+    wp_center += wps[i];
+  wp_center /= (double) numberBearingVectors;
+
+  //create inner summation terms
+  uwps.clear();
+  vwps.clear();
+  uwp_center = Eigen::Vector3d::Zero();
+  vwp_center = Eigen::Vector3d::Zero();
+  for( size_t i = 0; i < numberBearingVectors; i++ ) {
+    uwps.push_back( (wps[i]-wp_center) * fs[i][0] ); uwp_center += uwps.back();
+    vwps.push_back( (wps[i]-wp_center) * fs[i][1] ); vwp_center += vwps.back();
+  }
+  uwp_center /= (double) numberBearingVectors;
+  vwp_center /= (double) numberBearingVectors;
+}